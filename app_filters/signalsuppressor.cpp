@@ -37,18 +37,33 @@
 *       the work has completed.
 *
 * NOTES :
-*       The passed data must exist as part of QVariant and the receiving slot
-*       must mimic the following pseudo code:
+*       The SignalSuppressor base carries the signal and the bookkeeping while
+*       the ParameterSuppressor template carries the data itself. The data is
+*       held in a fixed-size slot of the parameter type that is overwritten in
+*       place, so no QVariant or QByteArray is allocated for each slider tick.
+*       The receiving slot must mimic the following pseudo code:
 *       RECEIVE_SUPPRESSOR(SignalSuppressor *ptr)
 *       {
 *          ...
-*          data = ptr->getNewData().toDATATYPE();
+*          data = static_cast<ParameterSuppressor<DATATYPE>*>(ptr)->getNewData();
 *          performWork(data);
 *       }
 *
-*       Signaling to the SignalSuppressor must also be done via the new signaling
-*       method mimicing the following pseudo code:
-*       connect(*signalingObj, &Class::method, thisObj, SignalSuppressor::receiveNewData);
+*       Signaling to the ParameterSuppressor must also be done via the new
+*       signaling method mimicing the following pseudo code:
+*       connect(*signalingObj, &Class::method, thisObj, ParameterSuppressor<DATATYPE>::receiveNewData);
+*
+*       Each value received is stamped with a generation number that increases
+*       by one for every new value. A worker can pass a pointer to getNewData to
+*       learn the generation of its data and check isSuperseded between stages of
+*       long work to abandon it as soon as a newer value has been sent:
+*       RECEIVE_SUPPRESSOR(SignalSuppressor *ptr)
+*       {
+*          int generation;
+*          data = static_cast<ParameterSuppressor<DATATYPE>*>(ptr)->getNewData(&generation);
+*          for(each stage)
+*             if(ptr->isSuperseded(generation)) return;
+*       }
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    January 11/23/2018
@@ -57,6 +72,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           11/23/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Generations, Typed Slots
 *
 ************************************************************************/
 #include "signalsuppressor.h"
@@ -67,35 +83,37 @@ SignalSuppressor::SignalSuppressor(QObject *parent) : QObject(parent)
 
 }
 
-/* receiveNewData takes new data from a signal (signaling thread / fast thread) and places it in the internal
- * container of the object while protecting it from a race condition via a mutex. The old data is overwritten
- * every time a new signal is sent. The signal is only emitted if the receiving (slow) thread has pulled (getNewData)
- * the data from the object. The internal flag is reset to release the signal the first instant more data is received.*/
-void SignalSuppressor::receiveNewData(QVariant newData)
+/* dataReceived must be called with the mutex held after the derived class has overwritten its data with
+ * the newest value from a signal (signaling thread / fast thread). The generation is advanced so work on
+ * the old data can be abandoned. The signal is only emitted if the receiving (slow) thread has pulled
+ * (getNewData) the data from the object. The internal flag is reset to release the signal the first
+ * instant more data is received.*/
+void SignalSuppressor::dataReceived()
 {
-    mutex.lock();
-    data_m = newData;
+    generation_m.fetchAndAddRelease(1);
     if(notWaitingForData)
     {
         notWaitingForData = false;
         emit suppressedSignal(this);
         qDebug() << "suppressed signal ACTIVATED";
     }
-    mutex.unlock();
 } //disconnecting signal / slot not an option as last value may be dropped during processing
 
 
-/* getNewData should be called by the receiving thread which has received this object's address through
- * a queued signal/slot connection. The slow thread slot should call this function to retrieve the most
- * recent data it has been passed, ignoring any other data being passed between work iterations.  */
-QVariant SignalSuppressor::getNewData()
+/* dataRetrieved must be called with the mutex held by the receiving thread which has received this
+ * object's address through a queued signal/slot connection, as the derived class copies out the most
+ * recent data it has been passed. Any other data passed between work iterations is ignored. Returns the
+ * generation of the data being retrieved.*/
+int SignalSuppressor::dataRetrieved()
 {
-    mutex.lock();
     notWaitingForData = true; //data has been retrieved. Next newest data will send one signal and wait
-    QVariant tmp = data_m;
-    mutex.unlock();
-    return tmp;
+    return generation_m.loadAcquire();
 }
 
-
-
+/* Returns true if newer data was received after the data of the given generation was retrieved. It does
+ * not lock, so the receiving thread can call it between the stages of its work and stop early, in which
+ * case suppressedSignal has already been emitted again for the newer data.*/
+bool SignalSuppressor::isSuperseded(int generation) const
+{
+    return generation_m.loadAcquire() != generation;
+}
@@ -37,18 +37,33 @@
 *       the work has completed.
 *
 * NOTES :
-*       The passed data must exist as part of QVariant and the receiving slot
-*       must mimic the following pseudo code:
+*       The SignalSuppressor base carries the signal and the bookkeeping while
+*       the ParameterSuppressor template carries the data itself. The data is
+*       held in a fixed-size slot of the parameter type that is overwritten in
+*       place, so no QVariant or QByteArray is allocated for each slider tick.
+*       The receiving slot must mimic the following pseudo code:
 *       RECEIVE_SUPPRESSOR(SignalSuppressor *ptr)
 *       {
 *          ...
-*          data = ptr->getNewData().toDATATYPE();
+*          data = static_cast<ParameterSuppressor<DATATYPE>*>(ptr)->getNewData();
 *          performWork(data);
 *       }
 *
-*       Signaling to the SignalSuppressor must also be done via the new signaling
-*       method mimicing the following pseudo code:
-*       connect(*signalingObj, &Class::method, thisObj, SignalSuppressor::receiveNewData);
+*       Signaling to the ParameterSuppressor must also be done via the new
+*       signaling method mimicing the following pseudo code:
+*       connect(*signalingObj, &Class::method, thisObj, ParameterSuppressor<DATATYPE>::receiveNewData);
+*
+*       Each value received is stamped with a generation number that increases
+*       by one for every new value. A worker can pass a pointer to getNewData to
+*       learn the generation of its data and check isSuperseded between stages of
+*       long work to abandon it as soon as a newer value has been sent:
+*       RECEIVE_SUPPRESSOR(SignalSuppressor *ptr)
+*       {
+*          int generation;
+*          data = static_cast<ParameterSuppressor<DATATYPE>*>(ptr)->getNewData(&generation);
+*          for(each stage)
+*             if(ptr->isSuperseded(generation)) return;
+*       }
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    January 11/23/2018
@@ -57,34 +72,65 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           11/23/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Generations, Typed Slots
 *
 ************************************************************************/
 #ifndef SIGNALSUPPRESSOR_H
 #define SIGNALSUPPRESSOR_H
 
 #include <QObject>
-#include <QVariant>
 #include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
 
 class SignalSuppressor : public QObject
 {
     Q_OBJECT
 public:
     explicit SignalSuppressor(QObject *parent = nullptr);
-    QVariant getNewData();
+    bool isSuperseded(int generation) const;
 
 signals:
     void suppressedSignal(SignalSuppressor *ptr);
 
-public slots:
-    void receiveNewData(QVariant newData);
-
 protected:
+    void dataReceived();
+    int dataRetrieved();
     QMutex mutex;
 
 private:
-    QVariant data_m;
+    QAtomicInt generation_m;
     bool notWaitingForData = true;
 };
 
+//moc does not support templates, so the typed slot lives in a subclass without Q_OBJECT and the
+//signal is inherited from the base. Parameters must be copy assignable without allocating.
+template<typename Parameters>
+class ParameterSuppressor : public SignalSuppressor
+{
+public:
+    explicit ParameterSuppressor(QObject *parent = nullptr) : SignalSuppressor(parent), data_m() {}
+
+    //called by the signaling (fast) thread, the previous value is overwritten in place
+    void receiveNewData(const Parameters &newData)
+    {
+        QMutexLocker locker(&mutex);
+        data_m = newData;
+        dataReceived();
+    }
+
+    //called by the receiving (slow) thread, returns a copy of the most recent value
+    Parameters getNewData(int *generation = nullptr)
+    {
+        QMutexLocker locker(&mutex);
+        int current = dataRetrieved();
+        if(generation)
+            *generation = current;
+        return data_m;
+    }
+
+private:
+    Parameters data_m;
+};
+
 #endif // SIGNALSUPPRESSOR_H
@@ -0,0 +1,433 @@
+/***********************************************************************
+* FILENAME :    batchprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The BatchProcessor is the headless (command line) entry point of the
+*       application. It loads a recipe of Adjust, Filter, Temperature, and
+*       Transform operations saved as JSON, then applies that recipe to every
+*       image passed on the command line and writes the results to an output
+*       directory. No MainWindow or QuickMenu is created so that the batch
+*       mode can be run on a server without a display.
+*
+* NOTES :
+*       See batchprocessor.h for the recipe format.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "batchprocessor.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSet>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+#include <cstring>
+#include <exception>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+/* Each runnable pulls images off of the shared queue in the BatchProcessor until the queue
+ * is empty. One runnable is started for each thread in the pool. */
+class BatchRunnable : public QRunnable
+{
+public:
+    explicit BatchRunnable(BatchProcessor *processor) : processor_m(processor) {}
+    void run() override { processor_m->processQueue(); }
+
+private:
+    BatchProcessor *processor_m;
+};
+
+// constructor
+BatchProcessor::BatchProcessor() : nextImage_m(0), failedImages_m(0), tiledCubeWarned_m(0)
+{
+    tiledPixelThreshold_m = 100000000;
+    colorCube_m = false;
+
+}
+
+/* Checks the raw command line arguments for the --batch flag, given either as --batch <recipe> or
+ * --batch=<recipe> as both are accepted by the parser in exec. This must be done before the
+ * application object is created so that a QCoreApplication (no display) can be created instead
+ * of the QApplication used by the GUI. */
+bool BatchProcessor::isBatchRequested(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--batch") == 0 || strncmp(argv[i], "--batch=", 8) == 0)
+            return true;
+    }
+    return false;
+}
+
+/* Parses the command line, loads the recipe, and processes every image passed to the application
+ * across all of the threads in the global thread pool. Returns 0 if every image was written
+ * successfully, else 1. */
+int BatchProcessor::exec(QCoreApplication &application)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("qcvTouchUp headless batch processing mode");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("batch", "Apply the operations in <recipe> to each image.", "recipe"));
+    parser.addOption(QCommandLineOption({"o", "output"}, "Directory the processed images are written to.", "directory"));
+    parser.addOption(QCommandLineOption({"j", "jobs"}, "Number of images processed at once (default all cores).", "count"));
+    parser.addOption(QCommandLineOption("tile-above", "Process images larger than <megapixels> one tile at a time"
+                                                      " through a scratch file (default 100).", "megapixels"));
+    parser.addOption(QCommandLineOption("color-cube", "Bake each run of adjust and temperature operations into a"
+                                                      " color cube and apply it in one pass (approximate). Not"
+                                                      " applied to images processed one tile at a time."));
+    parser.addPositionalArgument("images", "Images to process.", "images...");
+    parser.process(application);
+
+    if(!loadRecipe(parser.value("batch")))
+        return 1;
+
+    imagePaths_m = parser.positionalArguments();
+    if(imagePaths_m.isEmpty())
+    {
+        qWarning() << "No images were given to process";
+        return 1;
+    }
+
+    //every image is written to the output directory under its own file name, so the names must differ
+    QSet<QString> outputNames;
+    for(const QString &imagePath : imagePaths_m)
+    {
+        QString name = QFileInfo(imagePath).fileName();
+        if(outputNames.contains(name.toLower()))
+        {
+            qWarning() << "More than one image is named" << name << "- the outputs would overwrite each other";
+            return 1;
+        }
+        outputNames.insert(name.toLower());
+    }
+
+    outputDirectory_m = parser.value("output");
+    if(outputDirectory_m.isEmpty() || !QDir().mkpath(outputDirectory_m))
+    {
+        qWarning() << "Unable to access output directory:" << outputDirectory_m;
+        return 1;
+    }
+
+    if(parser.isSet("tile-above"))
+        tiledPixelThreshold_m = static_cast<qint64>(parser.value("tile-above").toDouble() * 1000000);
+
+    colorCube_m = parser.isSet("color-cube");
+
+    int jobs = QThread::idealThreadCount();
+    if(parser.isSet("jobs"))
+        jobs = parser.value("jobs").toInt();
+    if(jobs < 1) jobs = 1;
+    if(jobs > imagePaths_m.size()) jobs = imagePaths_m.size();
+
+    //parallelism is at the image level, so keep OpenCV from also spawning threads for every image
+    if(jobs > 1)
+        cv::setNumThreads(1);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    pool->setMaxThreadCount(jobs);
+    for(int i = 0; i < jobs; i++)
+        pool->start(new BatchRunnable(this));
+    pool->waitForDone();
+
+    int failed = failedImages_m.load();
+    qInfo() << "Processed" << imagePaths_m.size() - failed << "of" << imagePaths_m.size() << "images";
+    return failed ? 1 : 0;
+}
+
+/* Called from each thread of the pool. The processor is created once per thread and used
+ * for every image that thread takes from the queue.*/
+void BatchProcessor::processQueue()
+{
+    EditProcessor processor;
+    int index;
+    while((index = nextImage_m.fetchAndAddRelaxed(1)) < imagePaths_m.size())
+    {
+        if(!processImage(imagePaths_m.at(index), processor))
+            failedImages_m.ref();
+    }
+}
+
+/* Reads the recipe file into the list of operations. Any value not given in the recipe is set to the
+ * value that leaves the image unchanged. Returns false if the recipe cannot be read or an operation
+ * is not recognized. */
+bool BatchProcessor::loadRecipe(const QString &recipePath)
+{
+    QFile recipeFile(recipePath);
+    if(!recipeFile.open(QFile::ReadOnly))
+    {
+        qWarning() << "Unable to open recipe:" << recipePath;
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument recipe = QJsonDocument::fromJson(recipeFile.readAll(), &error);
+    recipeFile.close();
+    if(recipe.isNull())
+    {
+        qWarning() << "Unable to parse recipe:" << error.errorString();
+        return false;
+    }
+
+    QJsonArray operations = recipe.object().value("operations").toArray();
+    for(const QJsonValue &value : operations)
+    {
+        QJsonObject object = value.toObject();
+        QString name = object.value("operation").toString();
+        EditOperation operation{};
+
+        if(name == "adjust")
+        {
+            operation.type = EditOperation::Adjust;
+            operation.adjustParameters[AdjustProcessor::Brightness] = object.value("brightness").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Contrast] = object.value("contrast").toDouble(1.0);
+            operation.adjustParameters[AdjustProcessor::Depth] = object.value("depth").toDouble(255.0);
+            operation.adjustParameters[AdjustProcessor::Hue] = object.value("hue").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Saturation] = object.value("saturation").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Intensity] = object.value("intensity").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Gamma] = object.value("gamma").toDouble(1.0);
+            operation.adjustParameters[AdjustProcessor::Highlight] = object.value("highlight").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Shadows] = object.value("shadows").toDouble(0.0);
+            operation.adjustParameters[AdjustProcessor::Color] = object.value("grayscale").toBool(false) ? -1.0 : 1.0;
+        }
+        else if(name == "filter")
+        {
+            //names match the combo box entries in the filter menu
+            QString type = object.value("type").toString();
+            QString kernel = object.value("kernel").toString();
+            operation.type = EditOperation::Filter;
+            operation.filterParameters[FilterProcessor::KernelWeight] = object.value("weight").toInt(1);
+            if(type == "smooth")
+            {
+                operation.filterParameters[FilterProcessor::KernelOperation] = FilterProcessor::SmoothFilter;
+                if(kernel == "gaussian")
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterGaussian;
+                else if(kernel == "median")
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterMedian;
+                else
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterAverage;
+            }
+            else if(type == "sharpen")
+            {
+                operation.filterParameters[FilterProcessor::KernelOperation] = FilterProcessor::SharpenFilter;
+                if(kernel == "laplacian")
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterLaplacian;
+                else
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterUnsharpen;
+            }
+            else if(type == "edge")
+            {
+                operation.filterParameters[FilterProcessor::KernelOperation] = FilterProcessor::EdgeFilter;
+                if(kernel == "laplacian")
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterLaplacian;
+                else if(kernel == "sobel")
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterSobel;
+                else
+                    operation.filterParameters[FilterProcessor::KernelType] = FilterProcessor::FilterCanny;
+            }
+            else
+            {
+                qWarning() << "Unknown filter type in recipe:" << type;
+                return false;
+            }
+        }
+        else if(name == "temperature")
+        {
+            operation.type = EditOperation::Temperature;
+            operation.value = object.value("kelvin").toInt(6500);
+        }
+        else if(name == "rotate")
+        {
+            operation.type = EditOperation::Rotate;
+            operation.value = object.value("degrees").toInt(0);
+            operation.autoCrop = object.value("autoCrop").toBool(false);
+        }
+        else if(name == "flip")
+        {
+            //the value is the flipCode of cv::flip
+            operation.type = EditOperation::Flip;
+            QString axis = object.value("axis").toString("horizontal");
+            operation.value = axis == "vertical" ? 0 : axis == "both" ? -1 : 1;
+        }
+        else if(name == "crop")
+        {
+            operation.type = EditOperation::Crop;
+            operation.region = cv::Rect(object.value("x").toInt(), object.value("y").toInt(),
+                                        object.value("width").toInt(), object.value("height").toInt());
+        }
+        else if(name == "scale")
+        {
+            operation.type = EditOperation::Scale;
+            operation.region = cv::Rect(0, 0, object.value("width").toInt(), object.value("height").toInt());
+        }
+        else
+        {
+            qWarning() << "Unknown operation in recipe:" << name;
+            return false;
+        }
+        operations_m.append(operation);
+    }
+
+    qInfo() << "Loaded" << operations_m.size() << "operations from" << recipePath;
+    return true;
+}
+
+/* Loads a single image in the same way as MainWindow::loadImageIntoMemory, runs each operation of the
+ * recipe through the processor, and adopts the result as the master after each operation the same way
+ * MainWindow::applyPreviewToMaster does, without copying it. The result is written to the output directory using the
+ * same file name (and format) as the source image. */
+bool BatchProcessor::processImage(const QString &imagePath, EditProcessor &processor)
+{
+    cv::Mat masterImage;
+    cv::Mat previewImage;
+    //a large image may not fit in memory, which must only fail that image
+    try {
+        masterImage = cv::imread(imagePath.toStdString(), cv::IMREAD_COLOR);
+        if(!masterImage.empty())
+            cv::cvtColor(masterImage, masterImage, cv::COLOR_BGR2RGB);
+    } catch (const std::exception &e) {
+        qWarning() << imagePath << e.what();
+        masterImage.release();
+    }
+    if(masterImage.empty())
+    {
+        qWarning() << "Unable to open image:" << imagePath;
+        return false;
+    }
+
+    //very large images are edited one tile at a time so only the decoded image must fit in memory
+    if(static_cast<qint64>(masterImage.total()) > tiledPixelThreshold_m)
+        return processTiledImage(imagePath, masterImage);
+
+    for(int i = 0; i < operations_m.size(); i++)
+    {
+        //catch exeception and report so one bad image does not stop the batch
+        try {
+            //a run of color operations is baked into one cube when requested
+            int colorOperations = 0;
+            while(colorCube_m && i + colorOperations < operations_m.size()
+                  && EditProcessor::isColorOperation(operations_m.at(i + colorOperations)))
+                colorOperations++;
+
+            if(colorOperations > 0)
+            {
+                processor.applyColorChain(operations_m.constData() + i, colorOperations, masterImage, previewImage);
+                i += colorOperations - 1;
+            }
+            else
+                processor.apply(operations_m.at(i), masterImage, previewImage);
+
+            //edge detection produces a single channel image, the other operations expect RGB
+            if(previewImage.channels() == 1)
+                cv::cvtColor(previewImage, previewImage, cv::COLOR_GRAY2RGB);
+        } catch (const cv::Exception &e) {
+            qWarning() << imagePath << QString::fromStdString(e.msg);
+            return false;
+        } catch (const std::exception &e) {
+            qWarning() << imagePath << e.what();
+            return false;
+        }
+
+        /* the result is adopted rather than copied, as the processors render every operation into a new
+         * buffer. A crop is a region of the previous master, which stays allocated only while it is used.*/
+        masterImage = previewImage;
+        previewImage.release();
+    }
+
+    return writeImage(imagePath, masterImage);
+}
+
+/* Applies the recipe to an image larger than the tiled threshold. The decoded image is copied into tiles
+ * and released, then each operation is applied tile by tile from one TiledImage into another, paging the
+ * tiles to a scratch file as needed. The result is assembled again to be written as OpenCV can not
+ * encode an image in parts. The operations are always applied exactly, so --color-cube is reported once
+ * as not applying to these images.*/
+bool BatchProcessor::processTiledImage(const QString &imagePath, cv::Mat &image)
+{
+    if(colorCube_m && tiledCubeWarned_m.testAndSetRelaxed(0, 1))
+        qWarning() << "--color-cube does not apply to images processed one tile at a time, they are rendered exactly";
+
+    TiledProcessor processor;
+    TiledImage masterTiles;
+    TiledImage previewTiles;
+    try {
+        masterTiles.fromMat(image);
+        image.release();
+        for(const EditOperation &operation : operations_m)
+        {
+            processor.apply(operation, masterTiles, previewTiles);
+            masterTiles.swap(previewTiles);
+        }
+        previewTiles.release();
+        masterTiles.toMat(image);
+    } catch (const cv::Exception &e) {
+        qWarning() << imagePath << QString::fromStdString(e.msg);
+        return false;
+    } catch (const std::exception &e) {
+        qWarning() << imagePath << e.what();
+        return false;
+    }
+    return writeImage(imagePath, image);
+}
+
+// Converts the RGB image back to the OpenCV color space and writes it to the output directory.
+bool BatchProcessor::writeImage(const QString &imagePath, cv::Mat &image)
+{
+    QString outputPath = QDir(outputDirectory_m).filePath(QFileInfo(imagePath).fileName());
+    bool written = false;
+    try {
+        cv::cvtColor(image, image, cv::COLOR_RGB2BGR);
+        written = cv::imwrite(outputPath.toStdString(), image);
+    } catch (const cv::Exception &e) {
+        qWarning() << QString::fromStdString(e.msg);
+    } catch (const std::exception &e) {
+        qWarning() << e.what();
+    }
+
+    if(!written)
+    {
+        qWarning() << "Unable to write image:" << outputPath;
+        return false;
+    }
+    qInfo() << "Wrote" << outputPath;
+    return true;
+}
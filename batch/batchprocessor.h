@@ -0,0 +1,107 @@
+/***********************************************************************
+* FILENAME :    batchprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The BatchProcessor is the headless (command line) entry point of the
+*       application. It loads a recipe of Adjust, Filter, Temperature, and
+*       Transform operations saved as JSON, then applies that recipe to every
+*       image passed on the command line and writes the results to an output
+*       directory. No MainWindow or QuickMenu is created so that the batch
+*       mode can be run on a server without a display.
+*
+* NOTES :
+*       The images are processed in parallel. Each thread in the pool owns its
+*       own EditProcessor (the same core processors used by the editing
+*       workers) so that the member buffers inside of the processors are never
+*       shared between threads. The result of each operation becomes the
+*       master without a copy, so a crop only narrows the view of the image
+*       it was cropped from. Images above --tile-above megapixels (100 by
+*       default) are processed one tile at a time by a TiledProcessor so
+*       that the intermediate images are paged to a scratch file instead of
+*       held in memory. With --color-cube each run of adjust and temperature
+*       operations is baked into a ColorCube and applied in one pass. The
+*       recipe format is as follows, where the values are the same values the
+*       menus pass to their worker:
+*       {
+*          "operations": [
+*             {"operation": "adjust", "brightness": 0, "contrast": 1.0,
+*              "depth": 255, "hue": 0, "saturation": 0, "intensity": 0,
+*              "gamma": 1.0, "highlight": 0, "shadows": 0, "grayscale": false},
+*             {"operation": "filter", "type": "smooth", "kernel": "gaussian", "weight": 50},
+*             {"operation": "temperature", "kelvin": 3200},
+*             {"operation": "rotate", "degrees": 15, "autoCrop": true},
+*             {"operation": "flip", "axis": "horizontal"},
+*             {"operation": "crop", "x": 0, "y": 0, "width": 640, "height": 480},
+*             {"operation": "scale", "width": 1920, "height": 1080}
+*          ]
+*       }
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QAtomicInt>
+#include "../core/editprocessor.h"
+#include "../core/tiledprocessor.h"
+class QCoreApplication;
+
+class BatchProcessor
+{
+public:
+    explicit BatchProcessor();
+    static bool isBatchRequested(int argc, char *argv[]);
+    int exec(QCoreApplication &application);
+    void processQueue();
+
+private:
+    bool loadRecipe(const QString &recipePath);
+    bool processImage(const QString &imagePath, EditProcessor &processor);
+    bool processTiledImage(const QString &imagePath, cv::Mat &image);
+    bool writeImage(const QString &imagePath, cv::Mat &image);
+    QVector<EditOperation> operations_m;
+    QStringList imagePaths_m;
+    QString outputDirectory_m;
+    QAtomicInt nextImage_m;
+    QAtomicInt failedImages_m;
+    QAtomicInt tiledCubeWarned_m;
+    qint64 tiledPixelThreshold_m;
+    bool colorCube_m;
+};
+
+#endif // BATCHPROCESSOR_H
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# Benchmarks for the qcvTouchUp image processing core
+#
+#-------------------------------------------------
+
+# Console application that only depends on the core library and OpenCV
+CONFIG -= qt app_bundle
+CONFIG += console c++11
+
+TARGET = qcvBench
+
+TEMPLATE = app
+
+SOURCES += \
+    main.cpp
+
+include(../core/core.pri)
+include(../opencv.pri)
@@ -0,0 +1,337 @@
+/***********************************************************************
+* FILENAME :    main.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       This file creates the entry point for the benchmark executable.
+*       Every editing operation of the core library is timed on random RGB
+*       images of 1, 12, 24, 50 and 100 megapixels and the median latency,
+*       99th percentile latency, and throughput are written to stdout as a
+*       table.
+*
+* NOTES :
+*       Each case is run in three phases so the start up costs are reported
+*       separately from the steady state:
+*         warm-up - the first call of the case on a 100x100 image, the same
+*                   call the worker constructors make. This includes the
+*                   OpenCL program build when OpenCL is available. It is
+*                   reported in the rows of the first size only.
+*         cold    - the first call at each size on a new processor, which
+*                   includes the allocation of the intermediate buffers.
+*         warm    - the same processor called repeatedly at each size.
+*       Usage: qcvBench [--sizes 1,12,24,50,100] [--iterations N]
+*                       [--case <name filter>] [--csv <file>]
+*       The 100 megapixel images need several GB of memory for the source,
+*       destination, and intermediate buffers.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+
+#include "core/editprocessor.h"
+#include <opencv2/core.hpp>
+#include <opencv2/core/ocl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchCase
+    {
+        std::string name;
+        EditOperation operation;
+    };
+
+    struct BenchResult
+    {
+        std::string name;
+        double megapixels;
+        double warmupMs;
+        double coldMs;
+        double medianMs;
+        double p99Ms;
+        double throughput;
+    };
+
+    //operation with every parameter at the value that leaves the image unchanged
+    EditOperation identityOperation(EditOperation::Type type)
+    {
+        EditOperation operation{};
+        operation.type = type;
+        operation.adjustParameters[AdjustProcessor::Contrast] = 1.0f;
+        operation.adjustParameters[AdjustProcessor::Depth] = 255.0f;
+        operation.adjustParameters[AdjustProcessor::Gamma] = 1.0f;
+        operation.adjustParameters[AdjustProcessor::Color] = 1.0f;
+        return operation;
+    }
+
+    BenchCase adjustCase(const char *name, int index, float value)
+    {
+        BenchCase benchCase{name, identityOperation(EditOperation::Adjust)};
+        benchCase.operation.adjustParameters[index] = value;
+        return benchCase;
+    }
+
+    BenchCase filterCase(const char *name, int operation, int type, int weight)
+    {
+        BenchCase benchCase{name, identityOperation(EditOperation::Filter)};
+        benchCase.operation.filterParameters[FilterProcessor::KernelOperation] = operation;
+        benchCase.operation.filterParameters[FilterProcessor::KernelType] = type;
+        benchCase.operation.filterParameters[FilterProcessor::KernelWeight] = weight;
+        return benchCase;
+    }
+
+    /* One case for each path through the processors. Each adjust case moves a single parameter off
+     * of its initial value, the same as moving a single slider in the Adjust menu.*/
+    std::vector<BenchCase> makeCases()
+    {
+        std::vector<BenchCase> cases;
+        cases.push_back(adjustCase("adjust/brightness", AdjustProcessor::Brightness, 40.0f));
+        cases.push_back(adjustCase("adjust/contrast", AdjustProcessor::Contrast, 1.5f));
+        cases.push_back(adjustCase("adjust/depth", AdjustProcessor::Depth, 128.0f));
+        cases.push_back(adjustCase("adjust/hue", AdjustProcessor::Hue, 45.0f));
+        cases.push_back(adjustCase("adjust/saturation", AdjustProcessor::Saturation, 40.0f));
+        cases.push_back(adjustCase("adjust/intensity", AdjustProcessor::Intensity, 40.0f));
+        cases.push_back(adjustCase("adjust/gamma", AdjustProcessor::Gamma, 1.5f));
+        cases.push_back(adjustCase("adjust/highlight", AdjustProcessor::Highlight, 40.0f));
+        cases.push_back(adjustCase("adjust/shadows", AdjustProcessor::Shadows, 40.0f));
+        cases.push_back(adjustCase("adjust/grayscale", AdjustProcessor::Color, -1.0f));
+
+        cases.push_back(filterCase("filter/smooth-average", FilterProcessor::SmoothFilter, FilterProcessor::FilterAverage, 50));
+        cases.push_back(filterCase("filter/smooth-gaussian", FilterProcessor::SmoothFilter, FilterProcessor::FilterGaussian, 50));
+        cases.push_back(filterCase("filter/smooth-median", FilterProcessor::SmoothFilter, FilterProcessor::FilterMedian, 50));
+        cases.push_back(filterCase("filter/sharpen-unsharpen", FilterProcessor::SharpenFilter, FilterProcessor::FilterUnsharpen, 50));
+        cases.push_back(filterCase("filter/sharpen-laplacian", FilterProcessor::SharpenFilter, FilterProcessor::FilterLaplacian, 50));
+        cases.push_back(filterCase("filter/edge-canny", FilterProcessor::EdgeFilter, FilterProcessor::FilterCanny, 3));
+        cases.push_back(filterCase("filter/edge-laplacian", FilterProcessor::EdgeFilter, FilterProcessor::FilterLaplacian, 3));
+        cases.push_back(filterCase("filter/edge-sobel", FilterProcessor::EdgeFilter, FilterProcessor::FilterSobel, 3));
+
+        BenchCase temperature{"temperature", identityOperation(EditOperation::Temperature)};
+        temperature.operation.value = 3200;
+        cases.push_back(temperature);
+
+        BenchCase rotate{"transform/rotate", identityOperation(EditOperation::Rotate)};
+        rotate.operation.value = 15;
+        cases.push_back(rotate);
+
+        BenchCase rotateCrop{"transform/rotate-autocrop", identityOperation(EditOperation::Rotate)};
+        rotateCrop.operation.value = 15;
+        rotateCrop.operation.autoCrop = true;
+        cases.push_back(rotateCrop);
+
+        BenchCase rotateRight{"transform/rotate-90", identityOperation(EditOperation::Rotate)};
+        rotateRight.operation.value = 90;
+        cases.push_back(rotateRight);
+
+        BenchCase flip{"transform/flip", identityOperation(EditOperation::Flip)};
+        flip.operation.value = 1;
+        cases.push_back(flip);
+
+        //crop and scale regions depend on the image size and are set before each run
+        cases.push_back(BenchCase{"transform/crop", identityOperation(EditOperation::Crop)});
+        cases.push_back(BenchCase{"transform/scale", identityOperation(EditOperation::Scale)});
+        return cases;
+    }
+
+    //crop to the center quarter and scale to half size
+    EditOperation sizedOperation(EditOperation operation, const cv::Size &size)
+    {
+        if(operation.type == EditOperation::Crop)
+            operation.region = cv::Rect(size.width / 4, size.height / 4, size.width / 2, size.height / 2);
+        else if(operation.type == EditOperation::Scale)
+            operation.region = cv::Rect(0, 0, size.width / 2, size.height / 2);
+        return operation;
+    }
+
+    //random image of the given megapixels with a 3:2 aspect ratio (typical of a camera sensor)
+    cv::Mat makeImage(double megapixels)
+    {
+        int width = static_cast<int>(std::sqrt(megapixels * 1000000.0 * 1.5) + 0.5);
+        int height = static_cast<int>(width / 1.5 + 0.5);
+        cv::Mat image(height, width, CV_8UC3);
+        cv::randu(image, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+        return image;
+    }
+
+    double timeApply(EditProcessor &processor, const EditOperation &operation, const cv::Mat &src, cv::Mat &dst)
+    {
+        auto start = std::chrono::steady_clock::now();
+        processor.apply(operation, src, dst);
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    //nearest rank percentile of sorted samples
+    double percentile(const std::vector<double> &sorted, double fraction)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+        if(rank < 1) rank = 1;
+        return sorted[rank - 1];
+    }
+
+    double median(const std::vector<double> &sorted)
+    {
+        size_t middle = sorted.size() / 2;
+        if(sorted.size() % 2)
+            return sorted[middle];
+        return (sorted[middle - 1] + sorted[middle]) / 2.0;
+    }
+
+    std::vector<double> parseSizes(const char *list)
+    {
+        std::vector<double> sizes;
+        std::string value(list);
+        size_t start = 0;
+        while(start < value.size())
+        {
+            size_t end = value.find(',', start);
+            if(end == std::string::npos) end = value.size();
+            double size = std::atof(value.substr(start, end - start).c_str());
+            if(size > 0.0) sizes.push_back(size);
+            start = end + 1;
+        }
+        return sizes;
+    }
+
+    void printUsage()
+    {
+        std::printf("Usage: qcvBench [--sizes 1,12,24,50,100] [--iterations N] [--case <name filter>] [--csv <file>]\n");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<double> sizes = {1.0, 12.0, 24.0, 50.0, 100.0};
+    int iterations = 20;
+    std::string caseFilter;
+    const char *csvPath = nullptr;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc)
+            sizes = parseSizes(argv[++i]);
+        else if(std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = std::max(1, std::atoi(argv[++i]));
+        else if(std::strcmp(argv[i], "--case") == 0 && i + 1 < argc)
+            caseFilter = argv[++i];
+        else if(std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            csvPath = argv[++i];
+        else
+        {
+            printUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if(sizes.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::printf("OpenCL: %s, threads: %d, iterations: %d\n",
+                cv::ocl::Context::getDefault().ptr() ? "available" : "not available",
+                cv::getNumThreads(), iterations);
+
+    //the same image the worker constructors use to warm up
+    cv::Mat warmupImage(100, 100, CV_8UC3);
+    cv::randu(warmupImage, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+
+    std::vector<BenchCase> cases = makeCases();
+    std::vector<BenchResult> results;
+    std::vector<double> samples(iterations);
+    cv::Mat dst;
+
+    for(const double megapixels : sizes)
+    {
+        cv::Mat src = makeImage(megapixels);
+        std::printf("\n%.0f MP (%dx%d)\n", megapixels, src.cols, src.rows);
+        std::printf("%-28s %11s %10s %11s %11s %10s\n", "case", "warm-up ms", "cold ms", "median ms", "p99 ms", "MP/s");
+
+        for(const BenchCase &benchCase : cases)
+        {
+            if(!caseFilter.empty() && benchCase.name.find(caseFilter) == std::string::npos)
+                continue;
+
+            BenchResult result{benchCase.name, megapixels, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            //only the first size pays for the OpenCL build, later sizes report the warm-up as zero
+            if(megapixels == sizes.front())
+            {
+                EditProcessor warmupProcessor;
+                cv::Mat warmupDst;
+                result.warmupMs = timeApply(warmupProcessor, sizedOperation(benchCase.operation, warmupImage.size()),
+                                            warmupImage, warmupDst);
+            }
+
+            EditOperation operation = sizedOperation(benchCase.operation, src.size());
+            EditProcessor processor;
+            dst.release();
+            result.coldMs = timeApply(processor, operation, src, dst);
+
+            for(int i = 0; i < iterations; i++)
+                samples[i] = timeApply(processor, operation, src, dst);
+            std::sort(samples.begin(), samples.end());
+
+            result.medianMs = median(samples);
+            result.p99Ms = percentile(samples, 0.99);
+            result.throughput = result.medianMs > 0.0 ? megapixels / (result.medianMs / 1000.0) : 0.0;
+            results.push_back(result);
+
+            std::printf("%-28s %11.2f %10.2f %11.2f %11.2f %10.1f\n", result.name.c_str(), result.warmupMs,
+                        result.coldMs, result.medianMs, result.p99Ms, result.throughput);
+            std::fflush(stdout);
+        }
+    }
+
+    if(csvPath)
+    {
+        FILE *csv = std::fopen(csvPath, "w");
+        if(!csv)
+        {
+            std::fprintf(stderr, "Unable to write %s\n", csvPath);
+            return 1;
+        }
+        std::fprintf(csv, "case,megapixels,warmup_ms,cold_ms,median_ms,p99_ms,megapixels_per_s\n");
+        for(const BenchResult &result : results)
+            std::fprintf(csv, "%s,%.0f,%.3f,%.3f,%.3f,%.3f,%.2f\n", result.name.c_str(), result.megapixels,
+                         result.warmupMs, result.coldMs, result.medianMs, result.p99Ms, result.throughput);
+        std::fclose(csv);
+    }
+    return 0;
+}
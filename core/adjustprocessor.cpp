@@ -0,0 +1,464 @@
+/***********************************************************************
+* FILENAME :    adjustprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The AdjustProcessor performs the pixel operations for adjusting
+*       the color, brightness, contrast, pixel depth, hue, saturation,
+*       intensity including high and low adjustments to gamma correction.
+*       It takes a plain cv::Mat in and writes a plain cv::Mat out so it
+*       can be used by the AdjustWorker, the batch mode, and the
+*       benchmarks alike.
+*
+* NOTES :
+*       This object uses OpenCV OpenCL accelerated function calls
+*       implicitly when OpenCL hardware is available through OpenCV's UMat
+*       object calls. The operations were moved here from
+*       adjustworker.cpp, see that file and Issue #41 for the OpenCL
+*       initialization step performed by the worker.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "adjustprocessor.h"
+#include "stageprofiler.h"
+#include <opencv2/imgproc.hpp>
+#include <opencv2/core/ocl.hpp>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#define HUE_DEPTH_SEPARATION 30
+#define INTENSITY_DEPTH_SEPARATION 128
+#define SATURATION_DEPTH_SEPARATION INTENSITY_DEPTH_SEPARATION
+
+//each thread converts this many bytes of the image at a time so that the band stays in its cache
+#define HLS_BAND_BYTES 262144
+
+/* Converts a range of rows from RGB to HLS, applies the three channel HLS LUT, and converts them back
+ * to RGB. The rows are worked on in bands small enough to stay in the cache between the three steps so
+ * the image itself is only read once and written once.*/
+class HlsBandAdjuster : public cv::ParallelLoopBody
+{
+public:
+    HlsBandAdjuster(const cv::Mat &src, cv::Mat &dst, const cv::Mat &lookUpTable)
+        : src_m(src), dst_m(dst), lookUpTable_m(lookUpTable) {}
+
+    // Returns the number of rows of an RGB image with the given width that fit in one band
+    static int bandRows(int cols)
+    {
+        return std::max(1, HLS_BAND_BYTES / std::max(1, cols * 3));
+    }
+
+    void operator()(const cv::Range &range) const override
+    {
+        int bandRows = HlsBandAdjuster::bandRows(src_m.cols);
+        cv::Mat hls(std::min(bandRows, range.end - range.start), src_m.cols, CV_8UC3);
+        for(int row = range.start; row < range.end; row += bandRows)
+        {
+            int end = std::min(row + bandRows, range.end);
+            cv::Mat band = hls.rowRange(0, end - row);
+            cv::Mat dstBand = dst_m.rowRange(row, end);
+            cv::cvtColor(src_m.rowRange(row, end), band, cv::COLOR_RGB2HLS);
+            cv::LUT(band, lookUpTable_m, band);
+            cv::cvtColor(band, dstBand, cv::COLOR_HLS2RGB);
+        }
+    }
+
+private:
+    const cv::Mat &src_m;
+    cv::Mat &dst_m;
+    const cv::Mat &lookUpTable_m;
+};
+
+// constructor
+AdjustProcessor::AdjustProcessor()
+{
+    splitChannelsTmp_m.resize(3);
+
+    //the cached tables start out invalid, NaN is not equal to any parameter
+    const float invalid = std::numeric_limits<float>::quiet_NaN();
+    std::fill(hlsKey_m, hlsKey_m + HLS_KEY_COUNT, invalid);
+    std::fill(curveKey_m, curveKey_m + 3, invalid);
+    hueKey_m = invalid;
+    depthKey_m = invalid;
+    incremental_m = false;
+    hlsStageValid_m = false;
+    grayStageValid_m = false;
+}
+
+/* Performs the image adjustment operations from the Adjust menu on src and stores the result in
+ * dst. Only the operations for the corresponding parameters that have changed from their default
+ * value are performed. The parameter array must hold ParameterCount values ordered by ParameterIndex.
+ * Returns false, leaving dst unchanged, if the work was abandoned by the cancel check.*/
+bool AdjustProcessor::process(const cv::Mat &src, cv::Mat &dst, const float *parameter)
+{
+    StageTimer stage("adjust");
+
+    //--perform operations on hue, intensity, and saturation color space if values are not set to initial
+    bool adjustHls = parameter[Hue] != 0.0f || parameter[Intensity] != 0.0f
+            || parameter[Saturation] != 0.0f || parameter[Gamma] != 1.0f
+            || parameter[Highlight] != 0.0f || parameter[Shadows] != 0.0f
+            || parameter[Depth] < 255;
+    const float hlsKey[HLS_KEY_COUNT] = {parameter[Hue], parameter[Intensity], parameter[Saturation],
+                                         parameter[Gamma], parameter[Highlight], parameter[Shadows],
+                                         parameter[Depth]};
+
+    //the HLS stage (and the copy of the source) is only redone if the source or one of its parameters changed
+    if(!incremental_m || !hlsStageValid_m || !std::equal(hlsKey, hlsKey + HLS_KEY_COUNT, hlsStageKey_m))
+    {
+        hlsStageValid_m = false;
+        grayStageValid_m = false;
+        if(adjustHls)
+        {
+            buildHlsLookUpTable(parameter);
+            stage.lap("HLS LUT");
+            if(isCancelled()) return false;
+        }
+
+        if(adjustHls && !cv::ocl::useOpenCL())
+        {
+            /* Without OpenCL the HLS operations are done in one pass over memory. The source is converted
+             * to HLS, looked up, and converted back one cache sized band of rows at a time, with the bands
+             * spread across threads, writing straight into the buffer used by the remaining operations.*/
+            hlsImage_m.create(src.size(), src.type());
+            {
+                cv::Mat hlsAdjusted = hlsImage_m.getMat(cv::ACCESS_WRITE);
+                int bandRows = HlsBandAdjuster::bandRows(src.cols);
+                cv::parallel_for_(cv::Range(0, src.rows), HlsBandAdjuster(src, hlsAdjusted, hlsLookUpTable_m),
+                                  (src.rows + bandRows - 1) / bandRows);
+            }
+            stage.lap("fused HLS bands");
+            if(isCancelled()) return false;
+        }
+        else
+        {
+            //clone necessary because internal checks will prevent GUI image from cycling.
+            src.copyTo(hlsImage_m);
+            stage.lap("copy to UMat");
+            if(isCancelled()) return false;
+
+            //the three channel LUT applies the hue, intensity and saturation tables without a split and merge
+            if(adjustHls)
+            {
+                cv::cvtColor(hlsImage_m, hlsImage_m, cv::COLOR_RGB2HLS);
+                stage.lap("cvtColor RGB2HLS");
+                if(isCancelled()) return false;
+                cv::LUT(hlsImage_m, hlsLookUpTable_m, hlsImage_m);
+                stage.lap("LUT HLS");
+                if(isCancelled()) return false;
+                cv::cvtColor(hlsImage_m, hlsImage_m, cv::COLOR_HLS2RGB);
+                stage.lap("cvtColor HLS2RGB");
+                if(isCancelled()) return false;
+            }
+        }
+        std::copy(hlsKey, hlsKey + HLS_KEY_COUNT, hlsStageKey_m);
+        hlsStageValid_m = true;
+    }
+    const cv::UMat *result = &hlsImage_m;
+
+
+    //--convert from color to grayscale if != 1.0, reusing the last grayscale image if the HLS stage was reused
+    if(parameter[Color] != 1.0f)
+    {
+        if(!incremental_m || !grayStageValid_m)
+        {
+            cv::cvtColor(*result, splitChannelsTmp_m[0], cv::COLOR_RGB2GRAY);
+            splitChannelsTmp_m.at(0).copyTo(splitChannelsTmp_m.at(1));
+            splitChannelsTmp_m.at(0).copyTo(splitChannelsTmp_m.at(2));
+            cv::merge(splitChannelsTmp_m, grayImage_m);
+            stage.lap("grayscale");
+            if(isCancelled()) return false;
+            grayStageValid_m = true;
+        }
+        result = &grayImage_m;
+    }
+
+
+    //--perform contrast and brightness operation if sliders are not at initial positions
+    if (parameter[Brightness] != 0.0f || parameter[Contrast] != 1.0f)
+    {
+        float alpha = parameter[Contrast];
+        float beta = parameter[Brightness];
+
+        //calculate brightness correction
+        if(alpha >= 1)
+            beta += -72.8f * log2f(alpha);
+        else
+            beta += 127.0f * -log2f(alpha) / sqrtf(1 / alpha);
+
+        //perform contrast computation into its own buffer so the earlier stages stay cached
+        result->convertTo(implicitOclImage_m, -1, alpha, beta);
+        result = &implicitOclImage_m;
+        stage.lap("contrast and brightness");
+        if(isCancelled()) return false;
+    }
+
+    result->copyTo(dst);
+    stage.lap("copy to preview");
+    return true;
+}
+
+/* Keeps the output of each stage of process between calls so that a later call only recomputes from the
+ * earliest stage its changed parameters affect, e.g. only the contrast when the contrast slider moves.
+ * The caller must call sourceChanged whenever src is not the same image as in the last call.*/
+void AdjustProcessor::setIncremental(bool incremental)
+{
+    incremental_m = incremental;
+    sourceChanged();
+}
+
+// Drops the cached stages, the next call of process starts again from the source image
+void AdjustProcessor::sourceChanged()
+{
+    hlsStageValid_m = false;
+    grayStageValid_m = false;
+}
+
+/* Builds the three channel LUT applied to the image in the HLS color space. Each operation on a channel
+ * is a table of its own, so the tables are composed in the order they were once applied one at a time:
+ * hue then depth for the hue channel, intensity then gamma (with highlights and shadows) then depth for
+ * the intensity channel, and saturation for the saturation channel. The hue, curve and depth tables are
+ * kept between calls and only rebuilt when their own parameters change, and nothing is rebuilt at all if
+ * the slider that moved does not affect the HLS operations.*/
+void AdjustProcessor::buildHlsLookUpTable(const float *parameter)
+{
+    const float hlsKey[HLS_KEY_COUNT] = {parameter[Hue], parameter[Intensity], parameter[Saturation],
+                                         parameter[Gamma], parameter[Highlight], parameter[Shadows],
+                                         parameter[Depth]};
+    if(std::equal(hlsKey, hlsKey + HLS_KEY_COUNT, hlsKey_m))
+        return;
+    std::copy(hlsKey, hlsKey + HLS_KEY_COUNT, hlsKey_m);
+
+    uchar hue[256], intensity[256], saturation[256];
+    for(int i = 0; i < 256; i++)
+    {
+        hue[i] = static_cast<uchar>(i);
+        intensity[i] = static_cast<uchar>(i);
+        saturation[i] = static_cast<uchar>(i);
+    }
+
+    if(parameter[Hue] != 0.0f)
+    {
+        if(parameter[Hue] != hueKey_m)
+            buildHueTable(parameter[Hue]);
+        std::copy(hueTable_m, hueTable_m + 180, hue);
+    }
+
+    //adjust the intensity
+    if(parameter[Intensity] != 0.0f)
+    {
+        for(int i = 0; i < 256; i++)
+            intensity[i] = cv::saturate_cast<uchar>(intensity[i] + parameter[Intensity]);
+    }
+
+    //adjust the saturation
+    if(parameter[Saturation] != 0.0f)
+    {
+        for(int i = 0; i < 256; i++)
+            saturation[i] = cv::saturate_cast<uchar>(saturation[i] + parameter[Saturation]);
+    }
+
+    //adjust gamma, highlights, and shadows
+    if(parameter[Gamma] != 1.0f || parameter[Highlight] != 0.0f
+            || parameter[Shadows] != 0.0f)
+    {
+        if(parameter[Gamma] != curveKey_m[0] || parameter[Highlight] != curveKey_m[1]
+                || parameter[Shadows] != curveKey_m[2])
+            buildCurveTable(parameter[Gamma], parameter[Highlight], parameter[Shadows]);
+        for(int i = 0; i < 256; i++)
+            intensity[i] = curveTable_m[intensity[i]];
+    }
+
+    //--adjust the number of colors available of not at initial value of 255
+    if(parameter[Depth] < 255)
+    {
+        if(parameter[Depth] != depthKey_m)
+            buildDepthTables(parameter[Depth]);
+        for(int i = 0; i < 180; i++)
+            hue[i] = depthHueTable_m[hue[i]];
+        for(int i = 0; i < 256; i++)
+            intensity[i] = depthTable_m[intensity[i]];
+    }
+
+    //interleave the tables in the channel order of the HLS image, the existing LUT is reused
+    hlsLookUpTable_m.create(1, 256, CV_8UC3);
+    for(int i = 0; i < 256; i++)
+    {
+        cv::Vec3b &entry = hlsLookUpTable_m.at<cv::Vec3b>(i);
+        entry[0] = hue[i];
+        entry[1] = intensity[i];
+        entry[2] = saturation[i];
+    }
+}
+
+/* openCv hue is stored as 360/2 since uchar cannot store above 255 so a LUT is populated
+ * from 0 to 180 and phase shifted between -180 and 180 based on slider input. */
+void AdjustProcessor::buildHueTable(float hueShift)
+{
+    //map the current values to correct phase (only 180 cells used)
+    int hueShifted;
+    for(int i = 0; i < 180; i++)
+    {
+        hueShifted = i + hueShift;
+        if(hueShifted < 0)
+            hueShifted += 180;
+        else if(hueShifted > 179)
+            hueShifted -=180;
+        hueTable_m[i] = hueShifted;
+    }
+    hueKey_m = hueShift;
+}
+
+//adjust gamma by 255(i/255)^(1/gamma) where gamma 0.5 to 3.0, then apply the highlights and shadows
+void AdjustProcessor::buildCurveTable(float gamma, float highlight, float shadows)
+{
+    float tmpGamma;
+    for(int i = 0; i < 256; i++)
+    {
+        //adjust gamma
+        tmpGamma = 255.0f * powf(i / 255.0f, 1.0f / gamma);
+
+        /* Bound the shadow adjustment to all pixels below 149 such that the x axis is not
+         * crossed (output is not fliped) in the adjustment equation -(x/50.0)^4 + x and is
+         * handled as a step function. Function is deisned to taper towards zero as the bound
+         * is approached in conjunction with the highlight adjustment. Equation inverted for
+         * subtraction. Shadow operates on the gamma adjusted LUT from a range of -80 to 80*/
+        if(i < 149 && shadows != 0.0f)
+        {
+            float tmpShadow;
+            if(shadows > 0.0f)
+            {
+                //-(x/50.0)^4 + shadow
+                tmpShadow = -1 * powf(i / 50.0f, 4) + shadows;
+                if(tmpShadow > 0)
+                    tmpGamma += tmpShadow;
+            }
+            else
+            {
+                //(x/50.0)^4 - shadow .. (shadow is negative)
+                tmpShadow = powf(i / 50.0f, 4) + shadows;
+                if(tmpShadow < 0)
+                    tmpGamma += tmpShadow;
+            }
+        }
+
+        /* Bound the highlight adjustment to all pixels above 106 such that the x axis is not
+         * crossed (output is not fliped) in the adjustment equation -(x/50.0 - 5.1)^4 + x and is
+         * handled as a step function. Function is deisned to taper towards zero as the bound
+         * is approached in conjunction with the highlight adjustment.Equation inverted for
+         * subtraction. Highlight operates on the gamma adjusted LUT from a range of -80 to 80*/
+        if(i > 106 && highlight != 0.0f)
+        {
+            float tmpHighlight;
+            if(highlight > 0.0f)
+            {
+                //-(x/50.0 - 5.1)^4 + highlight
+                tmpHighlight = -1 * powf(i / 50.0f - 5.1f, 4) + highlight;
+                if(tmpHighlight > 0)
+                    tmpGamma += tmpHighlight;
+            }
+            else
+            {
+                //(x/50.0 - 5.1)^4 - highlight .. (highlight is negative)
+                tmpHighlight = powf(i / 50.0f - 5.1f, 4) + highlight;
+                if(tmpHighlight < 0)
+                    tmpGamma += tmpHighlight;
+            }
+        }
+
+        //limit gamma adjusted values
+        if(tmpGamma > 255)
+            tmpGamma = 255;
+        else if(tmpGamma < 0)
+            tmpGamma = 0;
+
+        curveTable_m[i] = tmpGamma;
+    }
+
+    curveKey_m[0] = gamma;
+    curveKey_m[1] = highlight;
+    curveKey_m[2] = shadows;
+}
+
+//builds the tables that reduce the number of hues and intensities available to the given depth
+void AdjustProcessor::buildDepthTables(float depth)
+{
+    //create and normalize LUT for 0 to 180 for Hue; replace pixel intensities based on their LUT value
+    float scaleFactor = 1.0f - (depth * (180.0f / 255.0f)) / 180.0f;
+    int mod;
+    for(int i = 0; i < 180; i++)
+    {
+        /*if color is closer to the lower hue separation level than the higher hue separation level in radians
+          (scaled by half for OpenCV - 180 not 360), scale towards the lower level, else scale towards the higher level */
+        mod = (i + 1) % HUE_DEPTH_SEPARATION;
+        if( mod <= HUE_DEPTH_SEPARATION / 2)
+            depthHueTable_m[i] = static_cast<uchar>(static_cast<float>(i + 1) - roundf(mod * scaleFactor));
+        else
+            depthHueTable_m[i] = static_cast<uchar>(static_cast<float>(i + 1) + roundf(((HUE_DEPTH_SEPARATION - mod) * scaleFactor) ));
+    }
+
+    //create and normalize LUT from 0 to largest intensity / saturation values, then scale from 0 to 255
+    float tmp;
+    scaleFactor = 1.0f - (depth / 255.0f);
+    for(int i = 0; i < 256; i++)
+    {
+        /*if color is closer to the lower hue separation level than the higher saturation separation level in 255 scaled value;
+          scale towards the lower level, else scale towards the higher level */
+        mod = (i + 1) % INTENSITY_DEPTH_SEPARATION;
+        if( mod <= INTENSITY_DEPTH_SEPARATION / 2)
+        {
+            tmp = static_cast<float>(i + 1) - roundf(mod * scaleFactor);
+            if(tmp > 255.0f)
+                tmp = 255.0f;
+            depthTable_m[i] = static_cast<uchar>(tmp);
+        }
+        else
+            depthTable_m[i] = static_cast<uchar>(static_cast<float>(i + 1) + floorf(((INTENSITY_DEPTH_SEPARATION - mod) * scaleFactor) ));
+    }
+    depthKey_m = depth;
+}
+
+/* Sets a function that is called between the stages of process. If it returns true the remaining stages
+ * are skipped, which lets a caller abandon work whose result is no longer wanted. An empty function
+ * (the default) always lets the work run to completion.*/
+void AdjustProcessor::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool AdjustProcessor::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
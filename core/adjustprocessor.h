@@ -0,0 +1,123 @@
+/***********************************************************************
+* FILENAME :    adjustprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The AdjustProcessor performs the pixel operations for adjusting
+*       the color, brightness, contrast, pixel depth, hue, saturation,
+*       intensity including high and low adjustments to gamma correction.
+*       It takes a plain cv::Mat in and writes a plain cv::Mat out so it
+*       can be used by the AdjustWorker, the batch mode, and the
+*       benchmarks alike.
+*
+* NOTES :
+*       This object uses OpenCV OpenCL accelerated function calls
+*       implicitly when OpenCL hardware is available through OpenCV's UMat
+*       object calls. It holds no locks and emits no signals; the caller
+*       is responsible for making sure the source and destination are not
+*       modified by another thread during processing. One object should be
+*       used per thread as the intermediate buffers are kept as members.
+*       The hue, intensity, saturation, gamma and depth operations are all
+*       per channel look ups in the HLS color space, so they are composed
+*       into a single three channel LUT. Without OpenCL the conversion to
+*       HLS, the LUT, and the conversion back are done band by band across
+*       threads in a single pass over the image. When incremental
+*       processing is enabled the output of the HLS and grayscale stages is
+*       kept so that only the stages after the changed slider are redone.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef ADJUSTPROCESSOR_H
+#define ADJUSTPROCESSOR_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+#include <array>
+#include <vector>
+
+//number of parameters the HLS look up table depends on
+#define HLS_KEY_COUNT 7
+
+class AdjustProcessor
+{
+public:
+    AdjustProcessor();
+    enum ParameterIndex
+    {
+        Brightness  = 0,
+        Contrast    = 1,
+        Depth       = 2,
+        Hue         = 3,
+        Saturation  = 4,
+        Intensity   = 5,
+        Gamma       = 6,
+        Highlight   = 7,
+        Shadows     = 8,
+        Color       = 9,
+
+        ParameterCount = 10
+    };
+    typedef std::array<float, ParameterCount> Parameters; //fixed size block passed from the menu
+    bool process(const cv::Mat &src, cv::Mat &dst, const float *parameter);
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    void setIncremental(bool incremental);
+    void sourceChanged();
+
+private:
+    bool isCancelled() const;
+    void buildHlsLookUpTable(const float *parameter);
+    void buildHueTable(float hueShift);
+    void buildCurveTable(float gamma, float highlight, float shadows);
+    void buildDepthTables(float depth);
+    std::function<bool()> cancelCheck_m;
+    cv::UMat implicitOclImage_m;
+    cv::UMat hlsImage_m;
+    cv::UMat grayImage_m;
+    bool incremental_m;
+    bool hlsStageValid_m;
+    bool grayStageValid_m;
+    float hlsStageKey_m[HLS_KEY_COUNT];
+    cv::Mat hlsLookUpTable_m;
+    float hlsKey_m[HLS_KEY_COUNT];
+    uchar hueTable_m[256];
+    float hueKey_m;
+    uchar curveTable_m[256];
+    float curveKey_m[3];
+    uchar depthHueTable_m[256];
+    uchar depthTable_m[256];
+    float depthKey_m;
+    std::vector <cv::UMat> splitChannelsTmp_m;
+};
+
+#endif // ADJUSTPROCESSOR_H
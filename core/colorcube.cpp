@@ -0,0 +1,191 @@
+/***********************************************************************
+* FILENAME :    colorcube.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The ColorCube bakes a chain of per pixel color operations (the
+*       Adjust and Temperature operations) into a lattice of RGB colors
+*       and applies it to an image with one trilinear look up per pixel.
+*       Baking costs the same for any image size and the look up costs the
+*       same no matter how many operations were baked, so previews stay
+*       fast without OpenCL.
+*
+* NOTES :
+*       See colorcube.h
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "colorcube.h"
+#include "stageprofiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/* Interpolates the color of each pixel in a range of rows from the eight lattice points around it. The
+ * position of every possible channel value along an axis is looked up from a table rather than being
+ * computed for each pixel.*/
+class ColorCubeApplier : public cv::ParallelLoopBody
+{
+public:
+    ColorCubeApplier(const cv::Mat &src, cv::Mat &dst, const std::vector<float> &cube, int size)
+        : src_m(src), dst_m(dst), cube_m(cube), size_m(size)
+    {
+        for(int i = 0; i < 256; i++)
+        {
+            float position = i * (size_m - 1) / 255.0f;
+            int index = std::min(static_cast<int>(position), size_m - 2);
+            index_m[i] = index;
+            weight_m[i] = position - index;
+        }
+    }
+
+    void operator()(const cv::Range &range) const override
+    {
+        const int strideB = 3;
+        const int strideG = size_m * 3;
+        const int strideR = size_m * size_m * 3;
+        for(int row = range.start; row < range.end; row++)
+        {
+            const uchar *in = src_m.ptr<uchar>(row);
+            uchar *out = dst_m.ptr<uchar>(row);
+            for(int col = 0; col < src_m.cols; col++, in += 3, out += 3)
+            {
+                float wr = weight_m[in[0]], wg = weight_m[in[1]], wb = weight_m[in[2]];
+                const float *c000 = &cube_m[index_m[in[0]] * strideR + index_m[in[1]] * strideG + index_m[in[2]] * strideB];
+                for(int channel = 0; channel < 3; channel++)
+                {
+                    const float *c = c000 + channel;
+                    float c00 = c[0] + (c[strideB] - c[0]) * wb;
+                    float c01 = c[strideG] + (c[strideG + strideB] - c[strideG]) * wb;
+                    float c10 = c[strideR] + (c[strideR + strideB] - c[strideR]) * wb;
+                    float c11 = c[strideR + strideG] + (c[strideR + strideG + strideB] - c[strideR + strideG]) * wb;
+                    float c0 = c00 + (c01 - c00) * wg;
+                    float c1 = c10 + (c11 - c10) * wg;
+                    out[channel] = cv::saturate_cast<uchar>(c0 + (c1 - c0) * wr);
+                }
+            }
+        }
+    }
+
+private:
+    const cv::Mat &src_m;
+    cv::Mat &dst_m;
+    const std::vector<float> &cube_m;
+    int size_m;
+    int index_m[256];
+    float weight_m[256];
+};
+
+/* Constructor builds the lattice image once. It holds size x size x size RGB pixels, with the red and
+ * green values selecting the row and the blue value the column, so that the baked result can be read
+ * back in the same order.*/
+ColorCube::ColorCube(int size)
+    : size_m(std::max(2, std::min(size, 256)))
+{
+    lattice_m.create(size_m * size_m, size_m, CV_8UC3);
+    for(int r = 0; r < size_m; r++)
+    {
+        for(int g = 0; g < size_m; g++)
+        {
+            uchar *pixel = lattice_m.ptr<uchar>(r * size_m + g);
+            for(int b = 0; b < size_m; b++, pixel += 3)
+            {
+                pixel[0] = cv::saturate_cast<uchar>(r * 255.0f / (size_m - 1));
+                pixel[1] = cv::saturate_cast<uchar>(g * 255.0f / (size_m - 1));
+                pixel[2] = cv::saturate_cast<uchar>(b * 255.0f / (size_m - 1));
+            }
+        }
+    }
+}
+
+/* Bakes the transform into the cube. The transform is given the lattice image and must store the result
+ * of the color operations in baked; it may only change each pixel based on its own color. Returns false,
+ * leaving the cube unbaked, if the transform returns false (e.g. the work was cancelled) or its result
+ * is not a three channel image of the lattice size.*/
+bool ColorCube::bake(const std::function<bool(const cv::Mat &lattice, cv::Mat &baked)> &transform)
+{
+    StageTimer stage("color cube");
+    cube_m.clear();
+    if(!transform(lattice_m, baked_m) || baked_m.size() != lattice_m.size() || baked_m.type() != CV_8UC3)
+        return false;
+
+    cube_m.resize(lattice_m.total() * 3);
+    for(int row = 0; row < baked_m.rows; row++)
+    {
+        const uchar *pixel = baked_m.ptr<uchar>(row);
+        std::copy(pixel, pixel + baked_m.cols * 3, cube_m.begin() + row * baked_m.cols * 3);
+    }
+    stage.lap("bake");
+    return true;
+}
+
+/* Applies the baked cube to src, an 8 bit RGB image, and stores the result in dst. dst may be src. If the
+ * cube has not been baked src is copied to dst unchanged.*/
+void ColorCube::apply(const cv::Mat &src, cv::Mat &dst) const
+{
+    if(!isBaked() || src.type() != CV_8UC3)
+    {
+        src.copyTo(dst);
+        return;
+    }
+
+    StageTimer stage("color cube");
+    dst.create(src.size(), src.type());
+    cv::parallel_for_(cv::Range(0, src.rows), ColorCubeApplier(src, dst, cube_m, size_m),
+                      cv::getNumThreads() * 4);
+    stage.lap("apply");
+}
+
+// Returns true if the cube holds a baked transform
+bool ColorCube::isBaked() const
+{
+    return !cube_m.empty();
+}
+
+// Returns the number of lattice points along each axis
+int ColorCube::size() const
+{
+    return size_m;
+}
+
+/* Returns true if the previews rendered without OpenCL should be approximated with a color cube. As the
+ * cube is not exact it is opt-in, set through the QCVTOUCHUP_COLOR_CUBE environment variable.*/
+bool ColorCube::previewEnabled()
+{
+    static const bool enabled = [](){
+        const char *value = std::getenv("QCVTOUCHUP_COLOR_CUBE");
+        return value && *value && std::strcmp(value, "0") != 0;
+    }();
+    return enabled;
+}
@@ -0,0 +1,85 @@
+/***********************************************************************
+* FILENAME :    colorcube.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The ColorCube bakes a chain of per pixel color operations (the
+*       Adjust and Temperature operations) into a lattice of RGB colors
+*       and applies it to an image with one trilinear look up per pixel.
+*       Baking costs the same for any image size and the look up costs the
+*       same no matter how many operations were baked, so previews stay
+*       fast without OpenCL.
+*
+* NOTES :
+*       The cube is baked by running the real processors on an image made
+*       of the lattice colors, so it always matches what the processors
+*       would do to those colors. Colors between the lattice points are
+*       interpolated, which softens hard steps such as the depth
+*       quantization; a larger cube (COLOR_CUBE_FINE_SIZE) follows them
+*       more closely. Applying the cube is spread across threads by row.
+*       One object should be used per thread. The cube is only used for
+*       the previews when the QCVTOUCHUP_COLOR_CUBE environment variable
+*       is set to a value other than 0 (see previewEnabled).
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef COLORCUBE_H
+#define COLORCUBE_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+#include <vector>
+
+//number of lattice points along each axis of the cube
+#define COLOR_CUBE_SIZE 33
+#define COLOR_CUBE_FINE_SIZE 65
+
+class ColorCube
+{
+public:
+    explicit ColorCube(int size = COLOR_CUBE_SIZE);
+    bool bake(const std::function<bool(const cv::Mat &lattice, cv::Mat &baked)> &transform);
+    void apply(const cv::Mat &src, cv::Mat &dst) const;
+    bool isBaked() const;
+    int size() const;
+    static bool previewEnabled();
+
+private:
+    int size_m;
+    cv::Mat lattice_m;
+    cv::Mat baked_m;
+    std::vector<float> cube_m;
+};
+
+#endif // COLORCUBE_H
@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Links the qcvcore static library into a project
+#
+#-------------------------------------------------
+
+# Include this file (before opencv.pri) from any project in the tree that uses
+# the core. Headers are included relative to the top of the source tree
+# (e.g. "core/adjustprocessor.h").
+INCLUDEPATH += $$clean_path($$PWD/..)
+DEPENDPATH += $$PWD
+
+QCVCORE_BUILD_DIR = $$shadowed($$PWD)
+win32{
+    CONFIG(debug, debug|release): QCVCORE_BUILD_DIR = $$QCVCORE_BUILD_DIR/debug
+    else: QCVCORE_BUILD_DIR = $$QCVCORE_BUILD_DIR/release
+}
+
+LIBS += -L$$QCVCORE_BUILD_DIR -lqcvcore
+
+win32-msvc*: PRE_TARGETDEPS += $$QCVCORE_BUILD_DIR/qcvcore.lib
+else: PRE_TARGETDEPS += $$QCVCORE_BUILD_DIR/libqcvcore.a
@@ -0,0 +1,50 @@
+#-------------------------------------------------
+#
+# GUI free image processing core for qcvTouchUp
+#
+#-------------------------------------------------
+
+# The core operates only on cv::Mat and does not depend on Qt so it can be
+# linked by the application, the batch mode, and the benchmarks.
+CONFIG -= qt
+CONFIG += staticlib c++11
+
+TARGET = qcvcore
+
+TEMPLATE = lib
+
+SOURCES += \
+    adjustprocessor.cpp \
+    filterprocessor.cpp \
+    temperatureprocessor.cpp \
+    transformprocessor.cpp \
+    editprocessor.cpp \
+    editgraph.cpp \
+    stageprofiler.cpp \
+    tiledimage.cpp \
+    tiledprocessor.cpp \
+    tiledeltastore.cpp \
+    triplebuffer.cpp \
+    openclwarmup.cpp \
+    colorcube.cpp \
+    fastblur.cpp \
+    fftconvolver.cpp
+
+HEADERS += \
+    adjustprocessor.h \
+    filterprocessor.h \
+    temperatureprocessor.h \
+    transformprocessor.h \
+    editprocessor.h \
+    editgraph.h \
+    stageprofiler.h \
+    tiledimage.h \
+    tiledprocessor.h \
+    tiledeltastore.h \
+    triplebuffer.h \
+    openclwarmup.h \
+    colorcube.h \
+    fastblur.h \
+    fftconvolver.h
+
+include(../opencv.pri)
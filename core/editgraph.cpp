@@ -0,0 +1,197 @@
+/***********************************************************************
+* FILENAME :    editgraph.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The EditGraph holds the edits made to an image as an ordered chain
+*       of stages: Adjust, then Temperature, then Filter, then Transform.
+*       The source image is never modified. Each stage holds the
+*       operations applied in it and caches its output, so changing a
+*       stage only recomputes from the nearest cached result upstream of
+*       it, and stages downstream of it are recomputed only when their
+*       output is next requested.
+*
+* NOTES :
+*       The cached outputs are never written to once they are set; every
+*       operation is rendered into a new buffer. A stage without
+*       operations shares the buffer of the stage before it, and a crop
+*       shares the buffer it was cropped from, so they cost no memory. The
+*       operations of a stage are applied in the order they were appended.
+*       Operations of a later stage never change the size seen by an
+*       earlier stage, so the regions of the Transform stage stay valid
+*       when an earlier stage is changed. An EditGraph must only be
+*       accessed by one thread at a time.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "editgraph.h"
+#include "stageprofiler.h"
+
+// constructor
+EditGraph::EditGraph()
+{
+    invalidateFrom(AdjustStage);
+}
+
+// Sets the image the edits are applied to and removes all of the edits.
+void EditGraph::setSource(const cv::Mat &image)
+{
+    clear();
+    source_m = image;
+}
+
+// the unedited image
+const cv::Mat &EditGraph::source() const
+{
+    return source_m;
+}
+
+// Removes all of the edits, keeping the source image
+void EditGraph::clear()
+{
+    for(int i = 0; i < StageCount; i++)
+        nodes_m[i].operations.clear();
+    invalidateFrom(AdjustStage);
+}
+
+/* Appends the operation to the stage it belongs to. If the output of that stage is cached, only the new
+ * operation is rendered, from the cached output. The stages after it are recomputed when next requested.*/
+void EditGraph::appendOperation(const EditOperation &operation)
+{
+    if(operation.type == EditOperation::None)
+        return;
+
+    Node &node = nodes_m[stageOf(operation.type)];
+    node.operations.push_back(operation);
+    if(node.valid)
+    {
+        cv::Mat rendered;
+        processor_m.apply(operation, node.output, rendered);
+        if(!rendered.empty())
+            node.output = rendered;
+    }
+    invalidateFrom(stageOf(operation.type) + 1);
+}
+
+/* Appends the operation to the stage it belongs to, adopting renderedOutput as the new output of that
+ * stage instead of rendering it again. renderedOutput must be the operation applied to output(stage)
+ * (e.g. the preview shown to the user). It is released so that the caller can not write into the cache.*/
+void EditGraph::appendOperation(const EditOperation &operation, cv::Mat &renderedOutput)
+{
+    Node &node = nodes_m[stageOf(operation.type)];
+    if(operation.type == EditOperation::None || !node.valid || renderedOutput.empty())
+    {
+        appendOperation(operation);
+        renderedOutput.release();
+        return;
+    }
+
+    node.operations.push_back(operation);
+    node.output = renderedOutput;
+    renderedOutput = cv::Mat();
+    invalidateFrom(stageOf(operation.type) + 1);
+}
+
+// Replaces the operations of a stage, such as when an edit is undone. The stage is recomputed when next requested.
+void EditGraph::setOperations(Stage stage, const std::vector<EditOperation> &operations)
+{
+    nodes_m[stage].operations = operations;
+    invalidateFrom(stage);
+}
+
+// the operations applied in the stage, in the order they are applied
+const std::vector<EditOperation> &EditGraph::operations(Stage stage) const
+{
+    return nodes_m[stage].operations;
+}
+
+/* Returns the image after every stage up to and including stage. Stages that are not cached are
+ * rendered starting from the nearest cached stage before them. May throw a cv::Exception if an
+ * operation is not valid for the image it is applied to.*/
+const cv::Mat &EditGraph::output(Stage stage)
+{
+    int first = stage;
+    while(first >= 0 && !nodes_m[first].valid)
+        first--;
+
+    for(int i = first + 1; i <= stage; i++)
+    {
+        StageTimer timer("edit graph");
+        const cv::Mat &input = i ? nodes_m[i - 1].output : source_m;
+        Node &node = nodes_m[i];
+        node.output = input;
+        for(const EditOperation &operation : node.operations)
+        {
+            cv::Mat rendered;
+            processor_m.apply(operation, node.output, rendered);
+            if(!rendered.empty())
+                node.output = rendered;
+        }
+        node.valid = true;
+        timer.lap("render stage");
+    }
+    return nodes_m[stage].output;
+}
+
+// true if the output of the stage is cached
+bool EditGraph::isCached(Stage stage) const
+{
+    return nodes_m[stage].valid;
+}
+
+// Returns the stage operations of the given type belong to.
+EditGraph::Stage EditGraph::stageOf(EditOperation::Type type)
+{
+    switch (type)
+    {
+    case EditOperation::Adjust:
+        return AdjustStage;
+    case EditOperation::Temperature:
+        return TemperatureStage;
+    case EditOperation::Filter:
+        return FilterStage;
+    default: //Rotate, Crop, and Scale
+        return TransformStage;
+    }
+}
+
+// Discards the cached output of the stage and every stage after it
+void EditGraph::invalidateFrom(int stage)
+{
+    for(int i = stage; i < StageCount; i++)
+    {
+        nodes_m[i].output.release();
+        nodes_m[i].valid = false;
+    }
+}
@@ -0,0 +1,101 @@
+/***********************************************************************
+* FILENAME :    editgraph.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The EditGraph holds the edits made to an image as an ordered chain
+*       of stages: Adjust, then Temperature, then Filter, then Transform.
+*       The source image is never modified. Each stage holds the
+*       operations applied in it and caches its output, so changing a
+*       stage only recomputes from the nearest cached result upstream of
+*       it, and stages downstream of it are recomputed only when their
+*       output is next requested.
+*
+* NOTES :
+*       The cached outputs are never written to once they are set; every
+*       operation is rendered into a new buffer. A stage without
+*       operations shares the buffer of the stage before it, and a crop
+*       shares the buffer it was cropped from, so they cost no memory. The
+*       operations of a stage are applied in the order they were appended.
+*       Operations of a later stage never change the size seen by an
+*       earlier stage, so the regions of the Transform stage stay valid
+*       when an earlier stage is changed. An EditGraph must only be
+*       accessed by one thread at a time.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef EDITGRAPH_H
+#define EDITGRAPH_H
+
+#include "editprocessor.h"
+#include <opencv2/core.hpp>
+#include <vector>
+
+class EditGraph
+{
+public:
+    EditGraph();
+    enum Stage
+    {
+        AdjustStage         = 0,
+        TemperatureStage    = 1,
+        FilterStage         = 2,
+        TransformStage      = 3,
+        StageCount          = 4
+    };
+    void setSource(const cv::Mat &image);
+    const cv::Mat &source() const;
+    void clear();
+    void appendOperation(const EditOperation &operation);
+    void appendOperation(const EditOperation &operation, cv::Mat &renderedOutput);
+    void setOperations(Stage stage, const std::vector<EditOperation> &operations);
+    const std::vector<EditOperation> &operations(Stage stage) const;
+    const cv::Mat &output(Stage stage = TransformStage);
+    bool isCached(Stage stage) const;
+    static Stage stageOf(EditOperation::Type type);
+
+private:
+    struct Node
+    {
+        std::vector<EditOperation> operations;
+        cv::Mat output;
+        bool valid;
+    };
+    void invalidateFrom(int stage);
+    Node nodes_m[StageCount];
+    cv::Mat source_m;
+    EditProcessor processor_m;
+};
+
+#endif // EDITGRAPH_H
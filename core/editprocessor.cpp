@@ -0,0 +1,120 @@
+/***********************************************************************
+* FILENAME :    editprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The EditProcessor owns one of each of the core processors and
+*       applies a single EditOperation to an image. It is the single entry
+*       point into the core library for callers that replay a list of
+*       edits, such as the batch mode and the benchmarks.
+*
+* NOTES :
+*       The processors keep intermediate buffers as members, so an
+*       EditProcessor must not be shared between threads. Create one per
+*       thread instead. The parameters of an EditOperation are stored in
+*       the same form the matching menu sends them to its worker.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "editprocessor.h"
+
+// constructor, the finer cube is used as its result is saved rather than previewed
+EditProcessor::EditProcessor()
+    : colorCube(COLOR_CUBE_FINE_SIZE)
+{
+
+}
+
+/* Applies the operation to src and stores the result in dst. For the Scale operation the region holds
+ * the exact output size. A crop does not copy the image; dst shares the buffer of src. May throw a
+ * cv::Exception if the region of a Crop or Scale operation is not valid for src.*/
+void EditProcessor::apply(const EditOperation &operation, const cv::Mat &src, cv::Mat &dst)
+{
+    switch (operation.type)
+    {
+    case EditOperation::Adjust:
+        adjust.process(src, dst, operation.adjustParameters);
+        break;
+    case EditOperation::Filter:
+        filter.process(src, dst, operation.filterParameters);
+        break;
+    case EditOperation::Temperature:
+        temperature.process(src, dst, operation.value);
+        break;
+    case EditOperation::Rotate:
+        transform.rotate(src, dst, operation.value, operation.autoCrop);
+        break;
+    case EditOperation::Crop:
+        transform.crop(src, dst, operation.region);
+        break;
+    case EditOperation::Scale:
+        transform.scale(src, dst, operation.region.size());
+        break;
+    case EditOperation::Flip:
+        transform.flip(src, dst, operation.value);
+        break;
+    default:
+        src.copyTo(dst);
+        break;
+    }
+}
+
+/* Applies count consecutive color operations (see isColorOperation) to src and stores the result in dst
+ * by baking them into the color cube and applying the cube once, rather than running each operation over
+ * the whole image. Any other operation in the list is skipped.*/
+void EditProcessor::applyColorChain(const EditOperation *operations, int count, const cv::Mat &src, cv::Mat &dst)
+{
+    bool baked = colorCube.bake([&](const cv::Mat &lattice, cv::Mat &result) {
+        lattice.copyTo(result);
+        for(int i = 0; i < count; i++)
+        {
+            if(operations[i].type == EditOperation::Adjust)
+                adjust.process(result, result, operations[i].adjustParameters);
+            else if(operations[i].type == EditOperation::Temperature)
+                temperature.process(result, result, operations[i].value);
+        }
+        return true;
+    });
+
+    if(baked)
+        colorCube.apply(src, dst);
+    else
+        src.copyTo(dst);
+}
+
+// Returns true if the operation only changes each pixel based on its own color and can be baked into a cube
+bool EditProcessor::isColorOperation(const EditOperation &operation)
+{
+    return operation.type == EditOperation::Adjust || operation.type == EditOperation::Temperature;
+}
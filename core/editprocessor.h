@@ -0,0 +1,126 @@
+/***********************************************************************
+* FILENAME :    editprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The EditProcessor owns one of each of the core processors and
+*       applies a single EditOperation to an image. It is the single entry
+*       point into the core library for callers that replay a list of
+*       edits, such as the batch mode and the benchmarks.
+*
+* NOTES :
+*       The processors keep intermediate buffers as members, so an
+*       EditProcessor must not be shared between threads. Create one per
+*       thread instead. The parameters of an EditOperation are stored in
+*       the same form the matching menu sends them to its worker; the value
+*       of a Flip is the flipCode of cv::flip. A run of
+*       Adjust and Temperature operations can instead be baked into a
+*       ColorCube and applied with one look up per pixel.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef EDITPROCESSOR_H
+#define EDITPROCESSOR_H
+
+#include "adjustprocessor.h"
+#include "filterprocessor.h"
+#include "temperatureprocessor.h"
+#include "transformprocessor.h"
+#include "colorcube.h"
+#include <algorithm>
+#include <opencv2/core.hpp>
+
+struct EditOperation
+{
+    enum Type
+    {
+        None        = 0,
+        Adjust      = 1,
+        Filter      = 2,
+        Temperature = 3,
+        Rotate      = 4,
+        Crop        = 5,
+        Scale       = 6,
+        Flip        = 7
+    };
+
+    Type type;
+    float adjustParameters[AdjustProcessor::ParameterCount];
+    int filterParameters[FilterProcessor::ParameterCount];
+    int value;
+    bool autoCrop;
+    cv::Rect region;
+
+    // true if both are the same type and the parameters used by that type are equal
+    bool operator==(const EditOperation &other) const
+    {
+        if(type != other.type)
+            return false;
+
+        switch (type)
+        {
+        case Adjust:
+            return std::equal(adjustParameters, adjustParameters + AdjustProcessor::ParameterCount, other.adjustParameters);
+        case Filter:
+            return std::equal(filterParameters, filterParameters + FilterProcessor::ParameterCount, other.filterParameters);
+        case Rotate:
+            return value == other.value && autoCrop == other.autoCrop;
+        case Crop:
+            return region == other.region;
+        case Scale:
+            return region.size() == other.region.size();
+        case None:
+            return true;
+        default: //Temperature and Flip
+            return value == other.value;
+        }
+    }
+};
+
+class EditProcessor
+{
+public:
+    EditProcessor();
+    void apply(const EditOperation &operation, const cv::Mat &src, cv::Mat &dst);
+    void applyColorChain(const EditOperation *operations, int count, const cv::Mat &src, cv::Mat &dst);
+    static bool isColorOperation(const EditOperation &operation);
+
+    AdjustProcessor adjust;
+    FilterProcessor filter;
+    TemperatureProcessor temperature;
+    TransformProcessor transform;
+    ColorCube colorCube;
+};
+
+#endif // EDITPROCESSOR_H
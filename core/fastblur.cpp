@@ -0,0 +1,265 @@
+/***********************************************************************
+* FILENAME :    fastblur.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FastBlur performs box and Gaussian blurs whose cost per pixel
+*       does not grow with the size of the kernel. Each box is a running
+*       sum that adds the pixel entering the window and subtracts the one
+*       leaving it, and a Gaussian is approximated by a stack of boxes.
+*       The row passes are spread across threads by row and the column
+*       passes by column.
+*
+* NOTES :
+*       See fastblur.h
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "fastblur.h"
+#include <algorithm>
+#include <cmath>
+
+//pixels are carried between the passes with this many bits of fraction
+#define FAST_BLUR_FRACTION_BITS 8
+//number of row elements each thread sums down the columns at a time
+#define FAST_BLUR_COLUMN_STRIPE 256
+
+namespace
+{
+    //index of every position from -radius to length + radius in a line reflected about its ends
+    std::vector<int> reflectedIndices(int length, int radius)
+    {
+        std::vector<int> indices(length + 2 * radius + 1);
+        for(int i = 0; i < static_cast<int>(indices.size()); i++)
+            indices[i] = cv::borderInterpolate(i - radius, length, cv::BORDER_REFLECT_101);
+        return indices;
+    }
+
+    /* Runs every box along each row of src (8 bit) and stores the result in dst (32 bit integers with
+     * FAST_BLUR_FRACTION_BITS of fraction). The row stays in the cache for all of the boxes.*/
+    class RowBoxes : public cv::ParallelLoopBody
+    {
+    public:
+        RowBoxes(const cv::Mat &src, cv::Mat &dst, const std::vector<int> &sizes)
+            : src_m(src), dst_m(dst), sizes_m(sizes)
+        {
+            for(size_t i = 0; i < sizes_m.size(); i++)
+                indices_m.push_back(reflectedIndices(src_m.cols, sizes_m[i] / 2));
+        }
+
+        void operator()(const cv::Range &range) const override
+        {
+            const int cn = src_m.channels();
+            const int width = src_m.cols;
+            std::vector<int> line(width * cn), next(width * cn);
+            for(int row = range.start; row < range.end; row++)
+            {
+                const uchar *in = src_m.ptr<uchar>(row);
+                for(int i = 0; i < width * cn; i++)
+                    line[i] = in[i] << FAST_BLUR_FRACTION_BITS;
+
+                for(size_t pass = 0; pass < sizes_m.size(); pass++)
+                {
+                    const int size = sizes_m[pass];
+                    const int radius = size / 2;
+                    const int *index = indices_m[pass].data() + radius; //index[x] for x in [-radius, width + radius]
+                    const double scale = 1.0 / size;
+                    for(int c = 0; c < cn; c++)
+                    {
+                        long long sum = 0;
+                        for(int k = -radius; k <= radius; k++)
+                            sum += line[index[k] * cn + c];
+                        for(int x = 0; x < width; x++)
+                        {
+                            next[x * cn + c] = static_cast<int>(sum * scale + 0.5);
+                            sum += line[index[x + radius + 1] * cn + c] - line[index[x - radius] * cn + c];
+                        }
+                    }
+                    line.swap(next);
+                }
+
+                std::copy(line.begin(), line.end(), dst_m.ptr<int>(row));
+            }
+        }
+
+    private:
+        const cv::Mat &src_m;
+        cv::Mat &dst_m;
+        const std::vector<int> &sizes_m;
+        std::vector<std::vector<int> > indices_m;
+    };
+
+    /* Runs one box down the columns of src (32 bit integers with fraction) and stores the result in dst,
+     * either in the same form or, if dst is 8 bit, rounded back to whole pixel values. Each stripe of
+     * columns is summed row by row so that memory is read in order.*/
+    class ColumnBox : public cv::ParallelLoopBody
+    {
+    public:
+        ColumnBox(const cv::Mat &src, cv::Mat &dst, int size)
+            : src_m(src), dst_m(dst), size_m(size), indices_m(reflectedIndices(src.rows, size / 2)) {}
+
+        void operator()(const cv::Range &range) const override
+        {
+            const int elements = src_m.cols * src_m.channels();
+            const int radius = size_m / 2;
+            const int *index = indices_m.data() + radius;
+            const double scale = dst_m.depth() == CV_8U ? 1.0 / (size_m << FAST_BLUR_FRACTION_BITS) : 1.0 / size_m;
+            for(int stripe = range.start; stripe < range.end; stripe++)
+            {
+                const int start = stripe * FAST_BLUR_COLUMN_STRIPE;
+                const int end = std::min(start + FAST_BLUR_COLUMN_STRIPE, elements);
+                std::vector<long long> sum(end - start, 0);
+                for(int k = -radius; k <= radius; k++)
+                {
+                    const int *in = src_m.ptr<int>(index[k]);
+                    for(int i = start; i < end; i++)
+                        sum[i - start] += in[i];
+                }
+
+                for(int row = 0; row < src_m.rows; row++)
+                {
+                    if(dst_m.depth() == CV_8U)
+                    {
+                        uchar *out = dst_m.ptr<uchar>(row);
+                        for(int i = start; i < end; i++)
+                            out[i] = cv::saturate_cast<uchar>(sum[i - start] * scale);
+                    }
+                    else
+                    {
+                        int *out = dst_m.ptr<int>(row);
+                        for(int i = start; i < end; i++)
+                            out[i] = static_cast<int>(sum[i - start] * scale + 0.5);
+                    }
+
+                    const int *entering = src_m.ptr<int>(index[row + radius + 1]);
+                    const int *leaving = src_m.ptr<int>(index[row - radius]);
+                    for(int i = start; i < end; i++)
+                        sum[i - start] += entering[i] - leaving[i];
+                }
+            }
+        }
+
+    private:
+        const cv::Mat &src_m;
+        cv::Mat &dst_m;
+        int size_m;
+        std::vector<int> indices_m;
+    };
+}
+
+// constructor
+FastBlur::FastBlur()
+{
+
+}
+
+/* Blurs src with a ksize x ksize box (the same as cv::blur with the default border) and stores the result
+ * in dst. An even ksize is rounded up to the next odd size. Returns false, leaving dst incomplete, if the
+ * work was abandoned by the cancel check.*/
+bool FastBlur::box(const cv::Mat &src, cv::Mat &dst, int ksize)
+{
+    return blur(src, dst, std::vector<int>(1, ksize | 1));
+}
+
+/* Blurs src with a stack of boxes approximating a Gaussian of the given sigma and stores the result in dst.
+ * Returns false, leaving dst incomplete, if the work was abandoned by the cancel check.*/
+bool FastBlur::gaussian(const cv::Mat &src, cv::Mat &dst, double sigma)
+{
+    return blur(src, dst, gaussianBoxSizes(sigma));
+}
+
+/* Returns the odd widths of the boxes whose stack has the variance of a Gaussian with the given sigma. The
+ * ideal width is between two odd sizes, so the smaller size is used for as many passes as needed to bring
+ * the variance closest to sigma squared and the larger size for the rest.*/
+std::vector<int> FastBlur::gaussianBoxSizes(double sigma, int passes)
+{
+    double ideal = std::sqrt(12.0 * sigma * sigma / passes + 1.0);
+    int lower = static_cast<int>(std::floor(ideal));
+    if(lower % 2 == 0) lower--;
+    lower = std::max(lower, 1);
+    int upper = lower + 2;
+
+    double lowerPasses = (12.0 * sigma * sigma - passes * lower * lower - 4.0 * passes * lower - 3.0 * passes)
+            / (-4.0 * lower - 4.0);
+    int lowerCount = std::max(0, std::min(passes, static_cast<int>(std::round(lowerPasses))));
+
+    std::vector<int> sizes;
+    for(int i = 0; i < passes; i++)
+        sizes.push_back(i < lowerCount ? lower : upper);
+    return sizes;
+}
+
+// Returns true if the image can be blurred by this object, else OpenCV must be used
+bool FastBlur::isSupported(const cv::Mat &src)
+{
+    return src.depth() == CV_8U && !src.empty();
+}
+
+/* Sets a function that is called between the passes of a blur. If it returns true the remaining passes
+ * are skipped, which lets a caller abandon work whose result is no longer wanted. An empty function
+ * (the default) always lets the work run to completion.*/
+void FastBlur::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool FastBlur::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
+
+/* Runs each box along the rows, then each box down the columns. The rows are all done in one pass as they
+ * stay in the cache, while each box down the columns reads the whole image so it is a pass of its own.
+ * The cancel check is called before each pass down the columns.*/
+bool FastBlur::blur(const cv::Mat &src, cv::Mat &dst, const std::vector<int> &sizes)
+{
+    const int cn = src.channels();
+    horizontal_m.create(src.size(), CV_32SC(cn));
+    cv::parallel_for_(cv::Range(0, src.rows), RowBoxes(src, horizontal_m, sizes));
+
+    const int stripes = (src.cols * cn + FAST_BLUR_COLUMN_STRIPE - 1) / FAST_BLUR_COLUMN_STRIPE;
+    dst.create(src.size(), src.type());
+    for(size_t pass = 0; pass < sizes.size(); pass++)
+    {
+        if(isCancelled()) return false;
+        bool last = pass + 1 == sizes.size();
+        if(!last)
+            vertical_m.create(src.size(), CV_32SC(cn));
+        cv::parallel_for_(cv::Range(0, stripes), ColumnBox(horizontal_m, last ? dst : vertical_m, sizes[pass]));
+        if(!last)
+            std::swap(horizontal_m, vertical_m);
+    }
+    return true;
+}
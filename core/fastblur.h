@@ -0,0 +1,85 @@
+/***********************************************************************
+* FILENAME :    fastblur.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FastBlur performs box and Gaussian blurs whose cost per pixel
+*       does not grow with the size of the kernel. Each box is a running
+*       sum that adds the pixel entering the window and subtracts the one
+*       leaving it, and a Gaussian is approximated by a stack of boxes.
+*       The row passes are spread across threads by row and the column
+*       passes by column.
+*
+* NOTES :
+*       Only 8 bit images are supported. The passes are done in integers
+*       with 8 bits of fraction between them so that stacking boxes does
+*       not add rounding error, and the borders are reflected in the same
+*       way as the OpenCV default (BORDER_REFLECT_101). The stacked boxes
+*       reach a little further than the kernel size given to
+*       cv::GaussianBlur, as they are sized from sigma (Kovesi, Fast
+*       Almost-Gaussian Filtering). The intermediate images are kept as
+*       members, so one object should be used per thread. A cancel check
+*       is called between the passes so stale work can be abandoned.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef FASTBLUR_H
+#define FASTBLUR_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+#include <vector>
+
+//number of box passes used to approximate a Gaussian
+#define FAST_BLUR_GAUSSIAN_PASSES 3
+
+class FastBlur
+{
+public:
+    FastBlur();
+    bool box(const cv::Mat &src, cv::Mat &dst, int ksize);
+    bool gaussian(const cv::Mat &src, cv::Mat &dst, double sigma);
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    static std::vector<int> gaussianBoxSizes(double sigma, int passes = FAST_BLUR_GAUSSIAN_PASSES);
+    static bool isSupported(const cv::Mat &src);
+
+private:
+    bool isCancelled() const;
+    bool blur(const cv::Mat &src, cv::Mat &dst, const std::vector<int> &sizes);
+    cv::Mat horizontal_m;
+    cv::Mat vertical_m;
+    std::function<bool()> cancelCheck_m;
+};
+
+#endif // FASTBLUR_H
@@ -0,0 +1,201 @@
+/***********************************************************************
+* FILENAME :    fftconvolver.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FftConvolver applies a 2D kernel to an 8 bit image in the
+*       frequency domain. The image is cut into tiles that are transformed
+*       with cv::dft, multiplied by the spectrum of the kernel, and
+*       transformed back, so the cost per pixel depends on the tile size
+*       rather than the kernel area.
+*
+* NOTES :
+*       See fftconvolver.h
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "fftconvolver.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    /* Convolves the tiles of the image in range one channel at a time. Each tile is read straight from src,
+     * reflecting the rows and columns that fall outside of it, so the image is never padded as a whole. The
+     * result of a tile is the correlation of the kernel with the tile; the first step x step values of it
+     * did not wrap around.*/
+    class TileConvolver : public cv::ParallelLoopBody
+    {
+    public:
+        TileConvolver(const cv::Mat &src, cv::Mat &dst, const cv::Mat &spectrum, int tile, int step, int radius,
+                      const std::function<bool()> &cancelCheck)
+            : src_m(src), dst_m(dst), spectrum_m(spectrum), tile_m(tile), step_m(step), radius_m(radius),
+              tilesAcross_m((dst.cols + step - 1) / step), cancelCheck_m(cancelCheck) {}
+
+        void operator()(const cv::Range &range) const override
+        {
+            const int cn = dst_m.channels();
+            cv::Mat tile(tile_m, tile_m, CV_32F);
+            std::vector<int> columns(tile_m);
+            for(int index = range.start; index < range.end; index++)
+            {
+                if(cancelCheck_m && cancelCheck_m()) return;
+                const int x0 = (index % tilesAcross_m) * step_m;
+                const int y0 = (index / tilesAcross_m) * step_m;
+                const int width = std::min(tile_m, src_m.cols + 2 * radius_m - x0);
+                const int height = std::min(tile_m, src_m.rows + 2 * radius_m - y0);
+                const int outWidth = std::min(step_m, dst_m.cols - x0);
+                const int outHeight = std::min(step_m, dst_m.rows - y0);
+
+                //offset of each column of the tile within a row of src, reflected at the borders
+                for(int x = 0; x < width; x++)
+                    columns[x] = cv::borderInterpolate(x0 + x - radius_m, src_m.cols, cv::BORDER_REFLECT_101) * cn;
+
+                for(int c = 0; c < cn; c++)
+                {
+                    tile = cv::Scalar(0);
+                    for(int y = 0; y < height; y++)
+                    {
+                        const int row = cv::borderInterpolate(y0 + y - radius_m, src_m.rows, cv::BORDER_REFLECT_101);
+                        const uchar *in = src_m.ptr<uchar>(row) + c;
+                        float *out = tile.ptr<float>(y);
+                        for(int x = 0; x < width; x++)
+                            out[x] = in[columns[x]];
+                    }
+
+                    cv::dft(tile, tile, 0, height);
+                    cv::mulSpectrums(tile, spectrum_m, tile, 0, true);
+                    cv::dft(tile, tile, cv::DFT_INVERSE | cv::DFT_SCALE, outHeight);
+
+                    for(int y = 0; y < outHeight; y++)
+                    {
+                        const float *in = tile.ptr<float>(y);
+                        uchar *out = dst_m.ptr<uchar>(y0 + y) + x0 * cn + c;
+                        for(int x = 0; x < outWidth; x++)
+                            out[x * cn] = cv::saturate_cast<uchar>(in[x]);
+                    }
+                }
+            }
+        }
+
+    private:
+        const cv::Mat &src_m;
+        cv::Mat &dst_m;
+        const cv::Mat &spectrum_m;
+        int tile_m;
+        int step_m;
+        int radius_m;
+        int tilesAcross_m;
+        const std::function<bool()> &cancelCheck_m;
+    };
+}
+
+// constructor
+FftConvolver::FftConvolver() : spectrumKey_m(-1), spectrumTile_m(0)
+{
+
+}
+
+/* Returns the side of the square tiles used for a kernel on an image. The tile is at least twice the kernel
+ * so that most of each transform is kept, but no larger than needed to cover the image in one tile.*/
+int FftConvolver::tileSize(const cv::Size &image, const cv::Size &kernel)
+{
+    int extent = std::max(kernel.width, kernel.height);
+    int tile = std::max(FFT_CONVOLVE_TILE, 2 * extent);
+    tile = std::min(tile, std::max(image.width, image.height) + extent - 1);
+    return cv::getOptimalDFTSize(tile);
+}
+
+/* Estimates the operations per pixel of the spatial and frequency domain paths and returns true if the
+ * frequency domain is the cheaper one. A tile costs a forward and an inverse transform per channel and the
+ * product of the spectrums, shared between the pixels of the tile that are kept.*/
+bool FftConvolver::isPreferred(const cv::Size &image, const cv::Size &kernel)
+{
+    if(std::max(kernel.width, kernel.height) < FFT_CONVOLVE_MIN_KERNEL || image.area() <= 0)
+        return false;
+
+    int tile = tileSize(image, kernel);
+    int step = tile - std::max(kernel.width, kernel.height) + 1;
+    double spatialCost = static_cast<double>(kernel.area());
+    double fftCost = tile * static_cast<double>(tile) * (2.0 * std::log2(static_cast<double>(tile) * tile) + 4.0)
+            / (static_cast<double>(step) * step);
+    return fftCost < spatialCost;
+}
+
+/* Correlates src with kernel in the same way as cv::filter2D(src, dst, CV_8U, kernel) and stores the result
+ * in dst. The key identifies the kernel, so the caller must pass a new key whenever the kernel changes. The
+ * kernel must be square, odd sized, and CV_32F. src and dst may be the same image, though the tiles then
+ * have to be read from a copy of src. Returns false, leaving dst incomplete, if the work was abandoned by
+ * the cancel check.*/
+bool FftConvolver::filter(const cv::Mat &src, cv::Mat &dst, const cv::Mat &kernel, int key)
+{
+    CV_Assert(src.depth() == CV_8U && kernel.type() == CV_32F && kernel.rows == kernel.cols);
+    const int radius = kernel.rows / 2;
+    const int tile = tileSize(src.size(), kernel.size());
+    const int step = tile - kernel.rows + 1;
+
+    //transform the kernel once for each key and tile size
+    if(key != spectrumKey_m || tile != spectrumTile_m || kernel.size() != spectrumKernel_m)
+    {
+        spectrum_m = cv::Mat::zeros(tile, tile, CV_32F);
+        kernel.copyTo(spectrum_m(cv::Rect(0, 0, kernel.cols, kernel.rows)));
+        cv::dft(spectrum_m, spectrum_m, 0, kernel.rows);
+        spectrumKey_m = key;
+        spectrumTile_m = tile;
+        spectrumKernel_m = kernel.size();
+    }
+
+    //the tiles overlap, so they must not read the rows other tiles have already written
+    cv::Mat source = src.data == dst.data ? src.clone() : src;
+    dst.create(src.size(), src.type());
+
+    const int tiles = ((src.cols + step - 1) / step) * ((src.rows + step - 1) / step);
+    cv::parallel_for_(cv::Range(0, tiles), TileConvolver(source, dst, spectrum_m, tile, step, radius, cancelCheck_m));
+    return !isCancelled();
+}
+
+/* Sets a function that is called between the tiles of a filter. If it returns true the remaining tiles
+ * are skipped, which lets a caller abandon work whose result is no longer wanted. An empty function
+ * (the default) always lets the work run to completion.*/
+void FftConvolver::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool FftConvolver::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
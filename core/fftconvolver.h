@@ -0,0 +1,86 @@
+/***********************************************************************
+* FILENAME :    fftconvolver.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FftConvolver applies a 2D kernel to an 8 bit image in the
+*       frequency domain. The image is cut into tiles that are transformed
+*       with cv::dft, multiplied by the spectrum of the kernel, and
+*       transformed back, so the cost per pixel depends on the tile size
+*       rather than the kernel area.
+*
+* NOTES :
+*       The tiles overlap by the kernel size less one (overlap-save) and
+*       only the part of each tile untouched by the circular wrap is kept,
+*       so the memory used is a few tiles per thread whatever the image
+*       size. Each tile is read straight from the image and the rows and
+*       columns beyond its edges are reflected as the tile is filled. The
+*       result matches cv::filter2D with the default border. The spectrum
+*       of the kernel is kept between calls made with the same key and
+*       tile size. The buffers are members, so one object should be used
+*       per thread. A cancel check is called before each tile so stale
+*       work can be abandoned.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef FFTCONVOLVER_H
+#define FFTCONVOLVER_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+
+//smallest size of the square tiles transformed by cv::dft
+#define FFT_CONVOLVE_TILE 512
+//kernels smaller than this are always applied spatially
+#define FFT_CONVOLVE_MIN_KERNEL 11
+
+class FftConvolver
+{
+public:
+    FftConvolver();
+    bool filter(const cv::Mat &src, cv::Mat &dst, const cv::Mat &kernel, int key);
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    static bool isPreferred(const cv::Size &image, const cv::Size &kernel);
+    static int tileSize(const cv::Size &image, const cv::Size &kernel);
+
+private:
+    bool isCancelled() const;
+    std::function<bool()> cancelCheck_m;
+    cv::Mat spectrum_m;
+    int spectrumKey_m;
+    int spectrumTile_m;
+    cv::Size spectrumKernel_m;
+};
+
+#endif // FFTCONVOLVER_H
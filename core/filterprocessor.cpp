@@ -0,0 +1,465 @@
+/***********************************************************************
+* FILENAME :    filterprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FilterProcessor performs the pixel operations for filtering
+*       the image such as sharpening, bluring, and edge detect. It takes a
+*       plain cv::Mat in and writes a plain cv::Mat out so it can be used
+*       by the FilterWorker, the batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       This object does not use the OpenCL enhancements offered
+*       implicitly through the UMat OpenCV object. The filtering
+*       operations had bugs associated with them. This may be bugs within
+*       the OpenCV Version used (3.3.1). The operations were moved here
+*       from filterworker.cpp.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "filterprocessor.h"
+#include "stageprofiler.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+//kernel size at and above which the smoothing uses the FastBlur instead of OpenCV
+#define FAST_BLUR_KERNEL_THRESHOLD 15
+//bytes of the source image each band aims to hold so that the band stays in the L2 cache
+#define FILTER_BAND_BYTES 524288
+//a band is at least this many times as tall as its halo so the halo is not most of the work
+#define FILTER_BAND_HALO_RATIO 4
+
+namespace
+{
+    /* Filters the image one band of rows at a time. Each band is read with a halo of rows above and below
+     * so that its rows match those of the whole image, and each call owns its own FilterProcessor as the
+     * processors keep buffers between operations. The bands are given to cv::parallel_for_ as separate
+     * stripes, so a thread that finishes early takes the next band waiting. The remaining bands are
+     * skipped once the cancel check reports the work is no longer wanted.*/
+    class BandFilter : public cv::ParallelLoopBody
+    {
+    public:
+        BandFilter(const cv::Mat &src, cv::Mat &dst, const int *parameter, const cv::Size &imageSize,
+                   int bandRows, int halo, double previewScale, const std::function<bool()> &cancelCheck)
+            : src_m(src), dst_m(dst), parameter_m(parameter), imageSize_m(imageSize),
+              bandRows_m(bandRows), halo_m(halo), previewScale_m(previewScale), cancelCheck_m(cancelCheck) {}
+
+        void operator()(const cv::Range &range) const override
+        {
+            FilterProcessor processor;
+            processor.setPreviewScale(previewScale_m);
+            cv::Mat band;
+            for(int i = range.start; i < range.end; i++)
+            {
+                if(cancelCheck_m && cancelCheck_m()) return;
+                int top = i * bandRows_m;
+                int bottom = std::min(top + bandRows_m, src_m.rows);
+                int haloTop = std::max(top - halo_m, 0);
+                int haloBottom = std::min(bottom + halo_m, src_m.rows);
+
+                //the band is filtered as an image of its own so that OpenCV does not read beyond the halo
+                cv::Mat haloBand = src_m.rowRange(haloTop, haloBottom).clone();
+                processor.filter(haloBand, band, parameter_m, imageSize_m);
+                band.rowRange(top - haloTop, bottom - haloTop).copyTo(dst_m.rowRange(top, bottom));
+            }
+        }
+
+    private:
+        const cv::Mat &src_m;
+        cv::Mat &dst_m;
+        const int *parameter_m;
+        const cv::Size &imageSize_m;
+        int bandRows_m;
+        int halo_m;
+        double previewScale_m;
+        const std::function<bool()> &cancelCheck_m;
+    };
+}
+
+// constructor
+FilterProcessor::FilterProcessor() : laplacianSize_m(-1), previewScale_m(1.0)
+{
+
+}
+
+/* Sets the kernel radius for a filter to a maximum of 0.015 times the smallest image dimension.
+ * The kernel size is then scaled between 1 and 100% of its maximum size through weightPercent.
+ * The result of this function must also always be odd. */
+int FilterProcessor::kernelSize(cv::Size image, int weightPercent)
+{
+    int ksize;
+    if(image.width > image.height)
+        ksize = image.height;
+    else
+        ksize = image.width;
+
+    if(weightPercent > 100)
+        weightPercent = 100;
+    else if(weightPercent < 1)
+        weightPercent = 1;
+
+    ksize *= 0.015 * (weightPercent / 100.0);
+
+    return ksize | 1;
+}
+
+/* Returns the size of the Laplacian kernel used for sharpening. At full resolution the kernel is weight
+ * pixels wide; a preview rendered from a reduced copy of the image passes the ratio of its width to the
+ * full resolution width as previewScale so the kernel covers the same share of the image. The result is
+ * always odd and at least 1.*/
+int FilterProcessor::laplacianKernelSize(int weight, double previewScale)
+{
+    int size = cvRound(weight * previewScale);
+    return size < 1 ? 1 : size | 1;
+}
+
+/* Sets the ratio of the width of the images passed to process to the width of the full resolution image
+ * the operation is applied to. Kernels given in pixels (the sharpening Laplacian) are scaled by it so a
+ * reduced preview matches the full resolution result. It is 1 (full resolution) by default.*/
+void FilterProcessor::setPreviewScale(double scale)
+{
+    previewScale_m = scale > 0.0 ? scale : 1.0;
+}
+
+/* Generates a 2D Laplacian kernel for use with OpenCV's Filter2D function. If the desired size is
+ * negative, the kernel will output a Mat with one element of 1. If passed an even size, the next
+ * greatest odd size is used.*/
+cv::Mat FilterProcessor::makeLaplacianKernel(int size)
+{
+    if(size < 1)
+        size = 1;
+    size |= 1; //must be odd
+    int matCenter = size >> 1;
+
+    //fill new kernel with zeroes
+    cv::Mat newKernel = cv::Mat::zeros(size, size, CV_32F);
+
+    //fill matrix from center; traverse approx 1/4 elements
+    int kernelPoint;
+    int kernelSum = 0;
+    for(int i = 0; i < matCenter + 1; i++)
+    {
+        for(int j = 0; j < matCenter + 1; j++)
+        {
+            kernelPoint = -(1 + i + j - matCenter);
+            if (kernelPoint > 0) kernelPoint = 0;
+
+            //top left
+            newKernel.at<float>(cv::Point(i, j)) = kernelPoint;
+
+            //bottom right
+            newKernel.at<float>(cv::Point(size - i - 1, size - j - 1)) = kernelPoint;
+
+            //do not write & count multiple times and to sum properly
+            if(i != size >> 1 && j != size >> 1)
+            {
+                kernelSum += kernelPoint * 4;
+
+                //top right
+                newKernel.at<float>(cv::Point(size - i - 1, j)) = kernelPoint;
+
+                //bottom left
+                newKernel.at<float>(cv::Point(i, size - j - 1)) = kernelPoint;
+            }
+            else
+            {
+                kernelSum += kernelPoint * 2;
+            }
+        }
+    }
+
+    //adjust the kernel sum to exclude the center point. Invert and set as center.
+    kernelSum -= newKernel.at<float>(cv::Point(matCenter, matCenter)) * 2;
+    newKernel.at<float>(cv::Point(matCenter, matCenter)) = -kernelSum;
+    return newKernel;
+}
+
+/* Returns the number of pixels beyond its edges a region of the image must include for the filter
+ * selected by parameter to produce the same result in that region as it would for the whole image.
+ * Used when the image is filtered one tile at a time. The Canny edge detector is only approximated
+ * by this as its hysteresis step can follow an edge across the whole image.*/
+int FilterProcessor::haloSize(const int *parameter, const cv::Size &imageSize)
+{
+    switch (parameter[KernelOperation])
+    {
+    case SmoothFilter:
+        if(parameter[KernelType] == FilterGaussian)
+            return gaussianRadius(kernelSize(imageSize, parameter[KernelWeight]));
+        return kernelSize(imageSize, parameter[KernelWeight]) / 2;
+    case SharpenFilter:
+        if(parameter[KernelType] == FilterLaplacian)
+            return 1 + laplacianKernelSize(parameter[KernelWeight]) / 2; //3x3 blur then the Laplacian kernel
+        return gaussianRadius(kernelSize(imageSize, parameter[KernelWeight])); //unsharp mask
+    case EdgeFilter:
+        return (parameter[KernelWeight] | 1) / 2 + 1; //Canny also needs the gradient of its neighbors
+    default:
+        return 0;
+    }
+}
+
+/* Performs the smoothing, sharpening, and edge detection operations from the Filter menu on src
+ * and stores the result in dst. Switch statement selects the type of smoothing that will be applied
+ * to the image. The parameter array must hold ParameterCount values ordered by ParameterIndex. If
+ * the operation is not recognized, dst is left unchanged. If src is a tile of a larger image, the
+ * size of the whole image must be passed as imageSize so that the kernel size matches it.
+ * Returns false, leaving dst incomplete, if the work was abandoned by the cancel check.*/
+bool FilterProcessor::process(const cv::Mat &src, cv::Mat &dst, const int *parameter, const cv::Size &imageSize)
+{
+    cv::Size kernelImageSize = imageSize.area() > 0 ? imageSize : src.size();
+    int rows = bandRows(src, parameter, kernelImageSize);
+    if(rows <= 0)
+        return filter(src, dst, parameter, kernelImageSize);
+
+    //the bands read src while dst is written, so they must not share memory
+    cv::Mat source = src.data == dst.data ? src.clone() : src;
+    dst.create(src.size(), src.type());
+    int bands = (src.rows + rows - 1) / rows;
+    cv::parallel_for_(cv::Range(0, bands), BandFilter(source, dst, parameter, kernelImageSize, rows,
+                                                      haloSize(parameter, kernelImageSize), previewScale_m,
+                                                      cancelCheck_m), bands);
+    return !isCancelled();
+}
+
+/* Sets a function that is called before each band, tile, or blur pass of process. If it returns true the
+ * remaining work is skipped, which lets a caller abandon work whose result is no longer wanted. An empty
+ * function (the default) always lets the work run to completion. The bands are filtered by processors of
+ * their own, so the check must be safe to call from several threads.*/
+void FilterProcessor::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+    fastBlur_m.setCancelCheck(cancelCheck);
+    fftConvolver_m.setCancelCheck(cancelCheck);
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool FilterProcessor::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
+
+/* Returns the number of rows in each band when the operation selected by parameter should be run as
+ * parallel bands, else 0. Canny is never banded as its hysteresis can cross the band halo, and neither
+ * are the operations already spread across threads by the FastBlur or FftConvolver. Images too small to
+ * split into at least two bands are also filtered whole.*/
+int FilterProcessor::bandRows(const cv::Mat &src, const int *parameter, const cv::Size &imageSize) const
+{
+    if(src.depth() != CV_8U || cv::getNumThreads() < 2)
+        return 0;
+
+    int ksize = kernelSize(imageSize, parameter[KernelWeight]);
+    switch (parameter[KernelOperation])
+    {
+    case SmoothFilter:
+        if(parameter[KernelType] != FilterMedian && ksize >= FAST_BLUR_KERNEL_THRESHOLD)
+            return 0;
+        break;
+    case SharpenFilter:
+        if(parameter[KernelType] == FilterLaplacian)
+        {
+            int size = laplacianKernelSize(parameter[KernelWeight], previewScale_m);
+            if(FftConvolver::isPreferred(src.size(), cv::Size(size, size)))
+                return 0;
+        }
+        else if(ksize >= FAST_BLUR_KERNEL_THRESHOLD)
+            return 0;
+        break;
+    case EdgeFilter:
+        if(parameter[KernelType] != FilterLaplacian && parameter[KernelType] != FilterSobel)
+            return 0;
+        break;
+    default:
+        return 0;
+    }
+
+    size_t rowBytes = src.cols * src.elemSize();
+    int rows = static_cast<int>(FILTER_BAND_BYTES / std::max<size_t>(rowBytes, 1));
+    rows = std::max(rows, FILTER_BAND_HALO_RATIO * haloSize(parameter, imageSize));
+    rows = std::max(rows, 1);
+    return src.rows >= 2 * rows ? rows : 0;
+}
+
+/* Runs the operation selected by parameter on the whole of src. kernelImageSize is the size the kernel
+ * is derived from, which is that of the whole image when src is a tile or band of it. Returns false,
+ * leaving dst incomplete, if the FastBlur or FftConvolver was stopped by the cancel check.*/
+bool FilterProcessor::filter(const cv::Mat &src, cv::Mat &dst, const int *parameter, const cv::Size &kernelImageSize)
+{
+    StageTimer stage("filter");
+
+    switch (parameter[KernelOperation])
+    {
+
+    case SmoothFilter:
+    {
+        int ksize = kernelSize(kernelImageSize, parameter[KernelWeight]);
+
+        switch (parameter[KernelType])
+        {
+
+        case FilterGaussian:
+        {
+            //For Gaussian, sigma should be 1/4 size of kernel. (HAS GLITCH WITH UMAT OUTPUT)
+            if(!gaussianBlur(src, dst, ksize)) return false;
+            stage.lap("GaussianBlur");
+            break;
+        }
+        case FilterMedian:
+        {
+            cv::medianBlur(src, dst, ksize);
+            stage.lap("medianBlur");
+            break;
+        }
+        default: //FilterAverage
+        {
+            if(!boxBlur(src, dst, ksize)) return false;
+            stage.lap("blur");
+            break;
+        }
+        }
+        break;
+    }
+    case SharpenFilter:
+    {
+        int ksize = kernelSize(kernelImageSize, parameter[KernelWeight]);
+
+        switch (parameter[KernelType])
+        {
+
+        case FilterLaplacian:
+        {
+            //blur first to reduce noise
+            cv::GaussianBlur(src, tmpImage_m, cv::Size(3, 3), 0);
+            if(!laplacianFilter(tmpImage_m, dst, laplacianKernelSize(parameter[KernelWeight], previewScale_m)))
+                return false;
+            cv::addWeighted(src, .9, dst, .1, 255 * 0.1, dst, src.depth());
+            stage.lap("Laplacian sharpen");
+            break;
+        }
+        default: //FilterUnsharpen
+        {
+            if(!gaussianBlur(src, tmpImage_m, ksize)) return false;
+            cv::addWeighted(src, 1.5, tmpImage_m, -0.5, 0, dst, src.depth());
+            stage.lap("unsharp mask");
+            break;
+        }
+        }
+        break;
+    }
+    case EdgeFilter:
+    {
+        switch (parameter[KernelType])
+        {
+
+        //these opencv functions can have aperature size of 1/3/5/7
+        case FilterLaplacian:
+        {
+            cv::Laplacian(src, dst, CV_8U, parameter[KernelWeight]);
+            stage.lap("Laplacian");
+            break;
+        }
+
+        case FilterSobel:
+        {
+            cv::Sobel(src, tmpImage_m, CV_8U, 1, 0, parameter[KernelWeight]);
+            cv::Sobel(src, dst, CV_8U, 0, 1, parameter[KernelWeight]);
+            cv::addWeighted(tmpImage_m, 0.5, dst, 0.5, 0, dst, src.depth());
+            stage.lap("Sobel");
+            break;
+        }
+
+        default: //FilterCanny
+        {
+            cv::Canny(src, dst, 80, 200, parameter[KernelWeight]);
+            stage.lap("Canny");
+            break;
+        }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return true;
+}
+
+/* Returns how far gaussianBlur reaches for the kernel size. The FastBlur stacks boxes whose radii add up to
+ * more than half the kernel, so its reach is used whenever it may be taken.*/
+int FilterProcessor::gaussianRadius(int ksize)
+{
+    int radius = ksize / 2;
+    if(ksize >= FAST_BLUR_KERNEL_THRESHOLD)
+    {
+        int boxRadii = 0;
+        for(int size : FastBlur::gaussianBoxSizes(ksize * 0.25))
+            boxRadii += size / 2;
+        radius = std::max(radius, boxRadii);
+    }
+    return radius;
+}
+
+/* Blurs src with a Gaussian whose sigma is 1/4 of the kernel size. Large kernels are passed to the FastBlur
+ * as the cost of cv::GaussianBlur grows with the kernel size. Returns false if the FastBlur was cancelled.*/
+bool FilterProcessor::gaussianBlur(const cv::Mat &src, cv::Mat &dst, int ksize)
+{
+    if(ksize >= FAST_BLUR_KERNEL_THRESHOLD && FastBlur::isSupported(src))
+        return fastBlur_m.gaussian(src, dst, ksize * 0.25);
+    cv::GaussianBlur(src, dst, cv::Size(ksize, ksize), ksize * 0.25);
+    return true;
+}
+
+/* Blurs src with a ksize x ksize box, using the threaded FastBlur for large kernels. Returns false if the
+ * FastBlur was cancelled.*/
+bool FilterProcessor::boxBlur(const cv::Mat &src, cv::Mat &dst, int ksize)
+{
+    if(ksize >= FAST_BLUR_KERNEL_THRESHOLD && FastBlur::isSupported(src))
+        return fastBlur_m.box(src, dst, ksize);
+    cv::blur(src, dst, cv::Size(ksize, ksize));
+    return true;
+}
+
+/* Applies the Laplacian kernel of the given size to src. The kernel is only rebuilt when the size changes,
+ * and large kernels are applied in the frequency domain where that is cheaper than cv::filter2D. Returns
+ * false if the FftConvolver was cancelled.*/
+bool FilterProcessor::laplacianFilter(const cv::Mat &src, cv::Mat &dst, int size)
+{
+    if(size != laplacianSize_m)
+    {
+        laplacianKernel_m = makeLaplacianKernel(size);
+        laplacianSize_m = size;
+    }
+
+    if(src.depth() == CV_8U && FftConvolver::isPreferred(src.size(), laplacianKernel_m.size()))
+        return fftConvolver_m.filter(src, dst, laplacianKernel_m, size);
+    cv::filter2D(src, dst, CV_8U, laplacianKernel_m);
+    return true;
+}
@@ -0,0 +1,124 @@
+/***********************************************************************
+* FILENAME :    filterprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The FilterProcessor performs the pixel operations for filtering
+*       the image such as sharpening, bluring, and edge detect. It takes a
+*       plain cv::Mat in and writes a plain cv::Mat out so it can be used
+*       by the FilterWorker, the batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       This object does not use the OpenCL enhancements offered
+*       implicitly through the UMat OpenCV object. The filtering
+*       operations had bugs associated with them. This may be bugs within
+*       the OpenCV Version used (3.3.1). The operations were moved here
+*       from filterworker.cpp. Gaussian and average smoothing, and the
+*       blur of the unsharp mask, use the FastBlur once the kernel reaches
+*       FAST_BLUR_KERNEL_THRESHOLD so that large kernels cost no more per
+*       pixel than small ones. The sharpening Laplacian kernel is as many
+*       pixels wide as its weight at full resolution, so it is scaled down
+*       by the preview scale when a reduced copy is filtered. Large Laplacian
+*       kernels are applied by the
+*       FftConvolver when its estimate says the frequency domain is faster.
+*       The remaining operations, other than Canny, are split into bands of
+*       rows sized for the L2 cache, each read with a halo of haloSize rows,
+*       and the bands are filtered in parallel by their own processors. A
+*       cancel check is called before each band, and is passed on to the
+*       FastBlur and FftConvolver, so stale previews can be abandoned.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef FILTERPROCESSOR_H
+#define FILTERPROCESSOR_H
+
+#include <opencv2/core.hpp>
+#include <array>
+#include <functional>
+#include "fastblur.h"
+#include "fftconvolver.h"
+
+class FilterProcessor
+{
+public:
+    FilterProcessor();
+    enum ParameterIndex
+    {
+        FilterAverage       = 0,
+        FilterGaussian      = 1,
+        FilterMedian        = 2,
+
+        FilterUnsharpen     = 0,
+        FilterLaplacian     = 1,
+
+        FilterCanny         = 0,
+        FilterSobel         = 2,
+
+        SmoothFilter        = 0,
+        SharpenFilter       = 1,
+        EdgeFilter          = 2,
+
+        KernelType          = 0,
+        KernelWeight        = 1,
+        KernelOperation     = 2,
+
+        ParameterCount      = 3
+    };
+    typedef std::array<int, ParameterCount> Parameters; //fixed size block passed from the menu
+    bool process(const cv::Mat &src, cv::Mat &dst, const int *parameter, const cv::Size &imageSize = cv::Size());
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    static int kernelSize(cv::Size image, int weightPercent);
+    static int laplacianKernelSize(int weight, double previewScale = 1.0);
+    void setPreviewScale(double scale);
+    static int haloSize(const int *parameter, const cv::Size &imageSize);
+    static cv::Mat makeLaplacianKernel(int size);
+    bool filter(const cv::Mat &src, cv::Mat &dst, const int *parameter, const cv::Size &kernelImageSize);
+
+private:
+    bool isCancelled() const;
+    int bandRows(const cv::Mat &src, const int *parameter, const cv::Size &imageSize) const;
+    static int gaussianRadius(int ksize);
+    bool gaussianBlur(const cv::Mat &src, cv::Mat &dst, int ksize);
+    bool boxBlur(const cv::Mat &src, cv::Mat &dst, int ksize);
+    bool laplacianFilter(const cv::Mat &src, cv::Mat &dst, int size);
+    cv::Mat tmpImage_m;
+    cv::Mat laplacianKernel_m;
+    int laplacianSize_m;
+    double previewScale_m;
+    FastBlur fastBlur_m;
+    FftConvolver fftConvolver_m;
+    std::function<bool()> cancelCheck_m;
+};
+
+#endif // FILTERPROCESSOR_H
@@ -0,0 +1,124 @@
+/***********************************************************************
+* FILENAME :    openclwarmup.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The OpenClWarmUp builds the OpenCL programs the editing processors
+*       use by running each of them once on a small random image, so that
+*       the first preview of a real image does not pay for the kernel
+*       compilation.
+*
+* NOTES :
+*       See openclwarmup.h
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "openclwarmup.h"
+#include "adjustprocessor.h"
+#include "filterprocessor.h"
+#include "temperatureprocessor.h"
+#include "transformprocessor.h"
+#include "stageprofiler.h"
+#include <opencv2/core.hpp>
+#include <opencv2/core/ocl.hpp>
+#include <atomic>
+#include <mutex>
+
+static std::once_flag warmUpFlags[OpenClWarmUp::ProcessorCount];
+static std::atomic<bool> warmUpDone[OpenClWarmUp::ProcessorCount];
+static std::atomic<bool> openClAvailable(false);
+
+/* Builds the OpenCL calls of the processor if it has not been done yet in this process. Blocks until
+ * the warm-up has finished, including when another thread started it.*/
+void OpenClWarmUp::run(Processor processor)
+{
+    std::call_once(warmUpFlags[processor], &OpenClWarmUp::warmUp, processor);
+}
+
+// Returns true once the warm-up of the processor has finished (or was not needed)
+bool OpenClWarmUp::isDone(Processor processor)
+{
+    return warmUpDone[processor].load(std::memory_order_acquire);
+}
+
+/* Returns true if the OpenCL context was created by a warm-up. Only meaningful once isDone is true for a
+ * processor, as the context is created by the warm-up itself so that the caller is never blocked by it.*/
+bool OpenClWarmUp::isAvailable()
+{
+    return openClAvailable.load(std::memory_order_acquire);
+}
+
+/* OpenCL initialization step to build the OpenCL calls in GPU before a processor is called with an
+ * attached image. The processor is a local so the buffers of the editing workers are left untouched.*/
+void OpenClWarmUp::warmUp(Processor processor)
+{
+    StageTimer stage("worker start up");
+    cv::ocl::Context ctx = cv::ocl::Context::getDefault();
+    openClAvailable.store(ctx.ptr() != nullptr, std::memory_order_release);
+    if (ctx.ptr())
+    {
+        cv::Mat tmpMat(100, 100, CV_8UC3);
+        cv::randu(tmpMat, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+        cv::Mat result;
+
+        switch(processor)
+        {
+        case Adjust:
+        {
+            AdjustProcessor::Parameters adjustParameters = {{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+            AdjustProcessor().process(tmpMat, result, adjustParameters.data());
+            stage.lap("adjust OpenCL warm-up");
+            break;
+        }
+        case Filter:
+        {
+            FilterProcessor::Parameters filterParameters = {{FilterProcessor::FilterGaussian, 50, FilterProcessor::SmoothFilter}};
+            FilterProcessor().process(tmpMat, result, filterParameters.data());
+            stage.lap("filter OpenCL warm-up");
+            break;
+        }
+        case Temperature:
+            TemperatureProcessor().process(tmpMat, result, 0);
+            stage.lap("temperature OpenCL warm-up");
+            break;
+        case Transform:
+            TransformProcessor().rotate(tmpMat, result, 45, false);
+            stage.lap("transform OpenCL warm-up");
+            break;
+        default:
+            break;
+        }
+    }
+    warmUpDone[processor].store(true, std::memory_order_release);
+}
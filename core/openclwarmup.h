@@ -0,0 +1,75 @@
+/***********************************************************************
+* FILENAME :    openclwarmup.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The OpenClWarmUp builds the OpenCL programs the editing processors
+*       use by running each of them once on a small random image, so that
+*       the first preview of a real image does not pay for the kernel
+*       compilation.
+*
+* NOTES :
+*       Each processor is warmed up at most once per process no matter how
+*       many workers request it or from which threads; callers that arrive
+*       while it is still running wait for it to finish. The processors are
+*       warmed up separately so that each editing worker can do its own
+*       part on its own thread and report when it is ready. Nothing is
+*       done if no OpenCL device is available.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef OPENCLWARMUP_H
+#define OPENCLWARMUP_H
+
+class OpenClWarmUp
+{
+public:
+    enum Processor
+    {
+        Adjust          = 0,
+        Filter          = 1,
+        Temperature     = 2,
+        Transform       = 3,
+
+        ProcessorCount  = 4
+    };
+    static void run(Processor processor);
+    static bool isDone(Processor processor);
+    static bool isAvailable();
+
+private:
+    static void warmUp(Processor processor);
+};
+
+#endif // OPENCLWARMUP_H
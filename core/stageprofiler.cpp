@@ -0,0 +1,179 @@
+/***********************************************************************
+* FILENAME :    stageprofiler.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The StageProfiler records the wall time of each stage of an image
+*       operation (e.g. the copy to a UMat, a color conversion, a LUT) so
+*       that slow previews can be traced to processing or displaying
+*       the result. Stages are grouped by category
+*       and the totals of each category are collected by the GUI for the
+*       status bar. If the QCVTOUCHUP_TRACE environment variable is set to
+*       a file path, every stage is also kept as an event and written to
+*       that file in the Chrome trace event format (viewable in
+*       chrome://tracing or Perfetto) when writeTrace is called.
+*
+* NOTES :
+*       A StageTimer is created at the start of an operation and lap is
+*       called after each stage, recording the time since the previous
+*       lap. OpenCV runs UMat operations asynchronously when OpenCL is
+*       used, so the time of a GPU stage may be recorded by the next stage
+*       that waits on its result. The profiler is thread safe; the
+*       category and stage names must be string literals (or otherwise
+*       outlive the profiler) as only the pointers are stored.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "stageprofiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//upper bound on the events kept for the trace file (roughly 40 bytes each)
+#define MAX_TRACE_EVENTS 1000000
+
+// constructor, enables the trace if the environment variable is set
+StageProfiler::StageProfiler() : epoch_m(Clock::now())
+{
+    const char *tracePath = std::getenv("QCVTOUCHUP_TRACE");
+    if(tracePath)
+        tracePath_m = tracePath;
+}
+
+// returns the profiler shared by every thread of the process
+StageProfiler &StageProfiler::instance()
+{
+    static StageProfiler profiler;
+    return profiler;
+}
+
+/* Adds the time between start and end to the total of the category. If tracing is enabled the stage
+ * is also stored as a trace event. Once the event limit is reached, further events are dropped but
+ * the totals are still updated.*/
+void StageProfiler::record(const char *category, const char *stage, Clock::time_point start, Clock::time_point end)
+{
+    double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    std::lock_guard<std::mutex> lock(mutex_m);
+
+    bool found = false;
+    for(Total &total : totals_m)
+    {
+        if(std::strcmp(total.category, category) == 0)
+        {
+            total.milliseconds += milliseconds;
+            found = true;
+            break;
+        }
+    }
+    if(!found)
+        totals_m.push_back(Total{category, milliseconds});
+
+    if(!tracePath_m.empty() && events_m.size() < MAX_TRACE_EVENTS)
+    {
+        TraceEvent event;
+        event.category = category;
+        event.stage = stage;
+        event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - epoch_m).count();
+        event.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        event.thread = threadIndex(std::this_thread::get_id());
+        events_m.push_back(event);
+    }
+}
+
+/* Returns the total time of each category recorded since the last call, in the order the categories
+ * were first recorded, and resets the totals.*/
+std::vector<StageProfiler::Total> StageProfiler::takeTotals()
+{
+    std::lock_guard<std::mutex> lock(mutex_m);
+    std::vector<Total> totals;
+    totals.swap(totals_m);
+    return totals;
+}
+
+// returns true if the stages are being kept for the trace file
+bool StageProfiler::isTracing() const
+{
+    return !tracePath_m.empty();
+}
+
+/* Writes every event recorded so far to the trace file as complete ("X") events of the Chrome trace
+ * event format. Returns false if tracing is disabled or the file could not be written.*/
+bool StageProfiler::writeTrace()
+{
+    std::lock_guard<std::mutex> lock(mutex_m);
+    if(tracePath_m.empty())
+        return false;
+
+    FILE *file = std::fopen(tracePath_m.c_str(), "w");
+    if(!file)
+        return false;
+
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    for(size_t i = 0; i < events_m.size(); i++)
+    {
+        const TraceEvent &event = events_m[i];
+        std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%d}%s\n",
+                     event.stage, event.category, event.startUs, event.durationUs, event.thread,
+                     i + 1 < events_m.size() ? "," : "");
+    }
+    std::fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+    return std::fclose(file) == 0;
+}
+
+// maps the thread id to a small number for the trace viewer; the mutex must be held
+int StageProfiler::threadIndex(std::thread::id id)
+{
+    for(size_t i = 0; i < threads_m.size(); i++)
+    {
+        if(threads_m[i] == id)
+            return static_cast<int>(i);
+    }
+    threads_m.push_back(id);
+    return static_cast<int>(threads_m.size() - 1);
+}
+
+// starts timing the first stage of the category
+StageTimer::StageTimer(const char *category)
+    : category_m(category), last_m(StageProfiler::Clock::now())
+{
+
+}
+
+// records the time since the previous lap (or construction) as the stage, then starts the next stage
+void StageTimer::lap(const char *stage)
+{
+    StageProfiler::Clock::time_point now = StageProfiler::Clock::now();
+    StageProfiler::instance().record(category_m, stage, last_m, now);
+    last_m = now;
+}
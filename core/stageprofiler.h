@@ -0,0 +1,115 @@
+/***********************************************************************
+* FILENAME :    stageprofiler.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The StageProfiler records the wall time of each stage of an image
+*       operation (e.g. the copy to a UMat, a color conversion, a LUT) so
+*       that slow previews can be traced to processing or displaying
+*       the result. Stages are grouped by category
+*       and the totals of each category are collected by the GUI for the
+*       status bar. If the QCVTOUCHUP_TRACE environment variable is set to
+*       a file path, every stage is also kept as an event and written to
+*       that file in the Chrome trace event format (viewable in
+*       chrome://tracing or Perfetto) when writeTrace is called.
+*
+* NOTES :
+*       A StageTimer is created at the start of an operation and lap is
+*       called after each stage, recording the time since the previous
+*       lap. OpenCV runs UMat operations asynchronously when OpenCL is
+*       used, so the time of a GPU stage may be recorded by the next stage
+*       that waits on its result. The profiler is thread safe; the
+*       category and stage names must be string literals (or otherwise
+*       outlive the profiler) as only the pointers are stored.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef STAGEPROFILER_H
+#define STAGEPROFILER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class StageProfiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Total
+    {
+        const char *category;
+        double milliseconds;
+    };
+
+    static StageProfiler &instance();
+    void record(const char *category, const char *stage, Clock::time_point start, Clock::time_point end);
+    std::vector<Total> takeTotals();
+    bool isTracing() const;
+    bool writeTrace();
+
+private:
+    struct TraceEvent
+    {
+        const char *category;
+        const char *stage;
+        long long startUs;
+        long long durationUs;
+        int thread;
+    };
+
+    StageProfiler();
+    int threadIndex(std::thread::id id);
+    std::mutex mutex_m;
+    Clock::time_point epoch_m;
+    std::string tracePath_m;
+    std::vector<Total> totals_m;
+    std::vector<TraceEvent> events_m;
+    std::vector<std::thread::id> threads_m;
+};
+
+class StageTimer
+{
+public:
+    explicit StageTimer(const char *category);
+    void lap(const char *stage);
+
+private:
+    const char *category_m;
+    StageProfiler::Clock::time_point last_m;
+};
+
+#endif // STAGEPROFILER_H
@@ -0,0 +1,140 @@
+/***********************************************************************
+* FILENAME :    temperatureprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TemperatureProcessor performs the pixel operations for
+*       shifting the color temperature of the image to mimic a lamp of the
+*       given Kelvin temperature. It takes a plain cv::Mat in and writes a
+*       plain cv::Mat out so it can be used by the TemperatureWorker, the
+*       batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       The operations were moved here from temperatureworker.cpp.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "temperatureprocessor.h"
+#include "stageprofiler.h"
+#include <opencv2/core/ocl.hpp>
+#include <algorithm>
+
+// constructor
+TemperatureProcessor::TemperatureProcessor() : lookUpKelvin_m(-1)
+{
+
+}
+
+/* Returns the red, green, and blue gains (0 to 255) for the Kelvin temperature from a table holding every
+ * temperature in the supported range. The table is filled on first use from the constexpr gain curves.*/
+const float *TemperatureProcessor::gains(int kelvin)
+{
+    static const std::vector<float> table = []()
+    {
+        std::vector<float> values;
+        values.reserve(3 * (TEMPERATURE_MAX_KELVIN - TEMPERATURE_MIN_KELVIN + 1));
+        for(int k = TEMPERATURE_MIN_KELVIN; k <= TEMPERATURE_MAX_KELVIN; k++)
+        {
+            values.push_back(redGain(k / 100.0));
+            values.push_back(greenGain(k / 100.0));
+            values.push_back(blueGain(k / 100.0));
+        }
+        return values;
+    }();
+
+    kelvin = std::min(std::max(kelvin, TEMPERATURE_MIN_KELVIN), TEMPERATURE_MAX_KELVIN);
+    return &table[3 * (kelvin - TEMPERATURE_MIN_KELVIN)];
+}
+
+/* Builds the 256 entry table of each channel for cv::LUT. Channels beyond the third (alpha) are left as
+ * they are.*/
+void TemperatureProcessor::buildLookUpTable(int kelvin, int channels)
+{
+    if(kelvin == lookUpKelvin_m && lookUpTable_m.channels() == channels)
+        return;
+
+    const float *gain = gains(kelvin);
+    lookUpTable_m.create(1, 256, CV_8UC(channels));
+    uchar *table = lookUpTable_m.ptr<uchar>(0);
+    for(int i = 0; i < 256; i++)
+        for(int c = 0; c < channels; c++)
+            table[i * channels + c] = c < 3 ? cv::saturate_cast<uchar>(i * (gain[c] / 255)) : i;
+    lookUpKelvin_m = kelvin;
+}
+
+/* Scales the red, green, and blue channels of src by the color of a black body radiator at the
+ * given Kelvin temperature and stores the result in dst. The gains are looked up in one pass over
+ * the interleaved image; with OpenCL enabled the pass is run on a UMat.
+ * Returns false, leaving dst unchanged, if the work was abandoned by the cancel check.*/
+bool TemperatureProcessor::process(const cv::Mat &src, cv::Mat &dst, int kelvin)
+{
+    StageTimer stage("temperature");
+    buildLookUpTable(kelvin, src.channels());
+    stage.lap("gain table");
+    if(isCancelled()) return false;
+
+    if(!cv::ocl::useOpenCL())
+    {
+        cv::LUT(src, lookUpTable_m, dst);
+        stage.lap("channel gain");
+        return true;
+    }
+
+    //clone necessary because internal checks will prevent GUI image from cycling.
+    src.copyTo(implicitOclImage_m);
+    stage.lap("copy to UMat");
+    if(isCancelled()) return false;
+
+    cv::LUT(implicitOclImage_m, lookUpTable_m, implicitOclImage_m);
+    stage.lap("channel gain");
+    if(isCancelled()) return false;
+
+    implicitOclImage_m.copyTo(dst);
+    stage.lap("copy to preview");
+    return true;
+}
+
+/* Sets a function that is called between the stages of process. If it returns true the remaining stages
+ * are skipped, which lets a caller abandon work whose result is no longer wanted. An empty function
+ * (the default) always lets the work run to completion.*/
+void TemperatureProcessor::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool TemperatureProcessor::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
@@ -0,0 +1,104 @@
+/***********************************************************************
+* FILENAME :    temperatureprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TemperatureProcessor performs the pixel operations for
+*       shifting the color temperature of the image to mimic a lamp of the
+*       given Kelvin temperature. It takes a plain cv::Mat in and writes a
+*       plain cv::Mat out so it can be used by the TemperatureWorker, the
+*       batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       The operations were moved here from temperatureworker.cpp. The
+*       channel gains are constexpr polynomials (Horner form, no pow) kept
+*       in a table for every Kelvin from TEMPERATURE_MIN_KELVIN to
+*       TEMPERATURE_MAX_KELVIN that is built once. The gains are applied to
+*       the interleaved image with one cv::LUT, without splitting it into
+*       planes.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TEMPERATUREPROCESSOR_H
+#define TEMPERATUREPROCESSOR_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+#include <vector>
+
+//range of Kelvin temperatures held in the gain table, values outside of it are clamped
+#define TEMPERATURE_MIN_KELVIN 1000
+#define TEMPERATURE_MAX_KELVIN 12000
+
+class TemperatureProcessor
+{
+public:
+    TemperatureProcessor();
+    bool process(const cv::Mat &src, cv::Mat &dst, int kelvin);
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    static constexpr float redGain(double x);
+    static constexpr float greenGain(double x);
+    static constexpr float blueGain(double x);
+    static const float *gains(int kelvin);
+
+private:
+    bool isCancelled() const;
+    void buildLookUpTable(int kelvin, int channels);
+    std::function<bool()> cancelCheck_m;
+    cv::UMat implicitOclImage_m;
+    cv::Mat lookUpTable_m;
+    int lookUpKelvin_m;
+};
+
+/* The color of a black body radiator at x hundred Kelvin on a 0 to 255 scale for each channel. The curve
+ * fit for each channel is a step function approximation.*/
+constexpr float TemperatureProcessor::redGain(double x)
+{
+    return x > 65.0 ? static_cast<float>(479.7143 + x * (-4.757143 + x * 0.02)) : 255.0f;
+}
+
+constexpr float TemperatureProcessor::greenGain(double x)
+{
+    return x > 65.0 ? static_cast<float>(369.3214 + x * (-2.502381 + x * 0.01))
+                    : static_cast<float>(-50.34577 + x * (13.21698 + x * (-0.2250017 + x * 0.001430717)));
+}
+
+constexpr float TemperatureProcessor::blueGain(double x)
+{
+    return x < 15.0 ? 0.0f : x > 70.0 ? 255.0f
+                    : static_cast<float>(260.1294 + x * (-51.0587 + x * (3.321611 + x * (-0.08684615
+                                          + x * (0.001048834 + x * -0.000004820513)))));
+}
+
+#endif // TEMPERATUREPROCESSOR_H
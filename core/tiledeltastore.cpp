@@ -0,0 +1,281 @@
+/***********************************************************************
+* FILENAME :    tiledeltastore.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TileDeltaStore keeps the undo history of an image stored as a
+*       TiledImage. For each edit only the tiles that the edit changed are
+*       kept, compressed losslessly, so that the history of a very large
+*       image costs a fraction of a copy of the image per step. Once the
+*       compressed history exceeds its memory budget the oldest steps are
+*       spilled to a scratch file.
+*
+* NOTES :
+*       Tiles are compressed with the PNG encoder of OpenCV (zlib) at its
+*       fastest level, which needs no dependency beyond the OpenCV modules
+*       the core already links. Tiles that do not compress are kept as raw
+*       bytes. If an edit changed the size of the image every tile of the
+*       previous image is kept. The history is a stack; only the newest
+*       step can be restored. The memory budget defaults to 256 MB and can
+*       be set in megabytes with the QCVTOUCHUP_UNDO_MEMORY environment
+*       variable. A TileDeltaStore must only be accessed by one thread at
+*       a time.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "tiledeltastore.h"
+#include "stageprofiler.h"
+#include <opencv2/imgcodecs.hpp>
+#include <cstdlib>
+#include <cstring>
+
+// constructor
+TileDeltaStore::TileDeltaStore(size_t memoryBudget)
+{
+    scratchFile_m = nullptr;
+    scratchEnd_m = 0;
+    memoryUsed_m = 0;
+    memoryBudget_m = memoryBudget;
+}
+
+// destructor closes, and therefore removes, the scratch file
+TileDeltaStore::~TileDeltaStore()
+{
+    clear();
+}
+
+/* Returns the memory budget used when none is passed to the constructor. It can be set in megabytes
+ * through the QCVTOUCHUP_UNDO_MEMORY environment variable, otherwise 256 MB is used.*/
+size_t TileDeltaStore::defaultMemoryBudget()
+{
+    const char *megabytes = std::getenv("QCVTOUCHUP_UNDO_MEMORY");
+    if(megabytes && std::atoi(megabytes) > 0)
+        return static_cast<size_t>(std::atoi(megabytes)) << 20;
+    return static_cast<size_t>(256) << 20;
+}
+
+/* Records an edit that turned before into after by keeping the tiles of before that differ from after.
+ * If the edit changed the size or type of the image, every tile of before is kept. Both images must
+ * use the same tile size.*/
+void TileDeltaStore::push(TiledImage &before, TiledImage &after)
+{
+    StageTimer stage("undo history");
+    Delta delta;
+    delta.size = before.size();
+    delta.type = before.type();
+    delta.onDisk = false;
+    delta.offset = 0;
+    delta.bytes = 0;
+    bool sameGrid = before.size() == after.size() && before.type() == after.type();
+
+    for(int i = 0; i < before.tileCount(); i++)
+    {
+        cv::Rect region = before.tileRect(i);
+        before.readRegion(region, beforeTile_m);
+        if(sameGrid)
+        {
+            //tiles read by readRegion are continuous so they can be compared as one block
+            after.readRegion(region, afterTile_m);
+            if(std::memcmp(beforeTile_m.data, afterTile_m.data, beforeTile_m.total() * beforeTile_m.elemSize()) == 0)
+                continue;
+        }
+
+        CompressedTile stored;
+        stored.index = i;
+        compress(beforeTile_m, stored);
+        delta.bytes += stored.length;
+        delta.tiles.push_back(std::move(stored));
+    }
+    stage.lap("compress changed tiles");
+
+    memoryUsed_m += delta.bytes;
+    deltas_m.push_back(std::move(delta));
+    spillToDisk();
+}
+
+/* Undoes the newest edit recorded by push. image must hold the result of that edit; it is replaced
+ * with the image from before the edit and the step is removed from the history. May throw a
+ * cv::Exception if the step can not be read back from the scratch file.*/
+void TileDeltaStore::restore(TiledImage &image)
+{
+    if(deltas_m.empty())
+        return;
+
+    StageTimer stage("undo history");
+    Delta &delta = deltas_m.back();
+    if(delta.onDisk)
+    {
+        //the newest step on disk is always at the end of the scratch file
+        if(seekScratch(delta.offset))
+            CV_Error(cv::Error::StsError, "Unable to seek in the undo history scratch file");
+        for(CompressedTile &stored : delta.tiles)
+        {
+            stored.bytes.resize(stored.length);
+            if(std::fread(stored.bytes.data(), 1, stored.length, scratchFile_m) != stored.length)
+                CV_Error(cv::Error::StsError, "Unable to read the undo history scratch file");
+        }
+        scratchEnd_m = delta.offset;
+    }
+    else
+    {
+        memoryUsed_m -= delta.bytes;
+    }
+
+    if(delta.size == image.size() && delta.type == image.type())
+    {
+        for(const CompressedTile &stored : delta.tiles)
+        {
+            cv::Rect region = image.tileRect(stored.index);
+            decompress(stored, region.size(), delta.type, beforeTile_m);
+            image.writeRegion(region.tl(), beforeTile_m);
+        }
+    }
+    else
+    {
+        TiledImage restored;
+        restored.create(delta.size, delta.type);
+        for(const CompressedTile &stored : delta.tiles)
+        {
+            cv::Rect region = restored.tileRect(stored.index);
+            decompress(stored, region.size(), delta.type, beforeTile_m);
+            restored.writeRegion(region.tl(), beforeTile_m);
+        }
+        image.swap(restored);
+    }
+    deltas_m.pop_back();
+    stage.lap("restore tiles");
+}
+
+// Removes every step of the history and the scratch file
+void TileDeltaStore::clear()
+{
+    deltas_m.clear();
+    if(scratchFile_m)
+    {
+        std::fclose(scratchFile_m);
+        scratchFile_m = nullptr;
+    }
+    scratchEnd_m = 0;
+    memoryUsed_m = 0;
+}
+
+// number of steps that can be restored
+int TileDeltaStore::count() const
+{
+    return static_cast<int>(deltas_m.size());
+}
+
+// bytes of compressed tiles held in memory (steps spilled to the scratch file are not counted)
+size_t TileDeltaStore::memoryUsed() const
+{
+    return memoryUsed_m;
+}
+
+/* Compresses an 8 bit tile losslessly with the PNG encoder at its fastest level. If the tile can not be
+ * encoded or does not get smaller, the raw pixels are kept instead.*/
+void TileDeltaStore::compress(const cv::Mat &tile, CompressedTile &stored)
+{
+    size_t rawLength = tile.total() * tile.elemSize();
+    stored.compressed = false;
+    if(tile.depth() == CV_8U && tile.channels() != 2)
+    {
+        std::vector<int> parameters = {cv::IMWRITE_PNG_COMPRESSION, 1};
+        stored.compressed = cv::imencode(".png", tile, stored.bytes, parameters) && stored.bytes.size() < rawLength;
+    }
+    if(!stored.compressed)
+        stored.bytes.assign(tile.data, tile.data + rawLength);
+    stored.length = stored.bytes.size();
+}
+
+// Restores a tile of the given size compressed by compress. The channel order is kept as PNG stores it unchanged.
+void TileDeltaStore::decompress(const CompressedTile &stored, const cv::Size &size, int type, cv::Mat &tile)
+{
+    if(stored.compressed)
+    {
+        tile = cv::imdecode(stored.bytes, cv::IMREAD_UNCHANGED);
+        if(tile.empty() || tile.type() != type || tile.cols != size.width || tile.rows != size.height)
+            CV_Error(cv::Error::StsError, "Undo history tile is corrupt");
+    }
+    else
+    {
+        tile.create(size, type);
+        std::memcpy(tile.data, stored.bytes.data(), stored.bytes.size());
+    }
+}
+
+/* Writes the oldest steps held in memory to the end of the scratch file until the memory budget is met.
+ * The newest step always stays in memory as it is the next to be restored. Steps on disk are always
+ * older than the steps in memory so the scratch file grows and shrinks like the history itself. A step
+ * is only released from memory once all of it is written; if the scratch file fails it stays in memory.*/
+void TileDeltaStore::spillToDisk()
+{
+    for(size_t i = 0; i + 1 < deltas_m.size() && memoryUsed_m > memoryBudget_m; i++)
+    {
+        Delta &delta = deltas_m[i];
+        if(delta.onDisk)
+            continue;
+
+        if(!scratchFile_m)
+            scratchFile_m = std::tmpfile();
+        if(!scratchFile_m || seekScratch(scratchEnd_m))
+            return; //keep the step in memory rather than lose the history
+
+        long long offset = scratchEnd_m;
+        for(const CompressedTile &stored : delta.tiles)
+        {
+            if(std::fwrite(stored.bytes.data(), 1, stored.length, scratchFile_m) != stored.length)
+            {
+                scratchEnd_m = offset;
+                return; //keep the step in memory rather than lose the history
+            }
+            scratchEnd_m += stored.length;
+        }
+
+        for(CompressedTile &stored : delta.tiles)
+            std::vector<uchar>().swap(stored.bytes);
+        delta.offset = offset;
+        delta.onDisk = true;
+        memoryUsed_m -= delta.bytes;
+    }
+}
+
+// Moves the scratch file position to offset, which can exceed 2 GB. Returns non-zero on failure like fseek.
+int TileDeltaStore::seekScratch(long long offset)
+{
+#ifdef _WIN32
+    return _fseeki64(scratchFile_m, offset, SEEK_SET);
+#else
+    return fseeko(scratchFile_m, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
@@ -0,0 +1,109 @@
+/***********************************************************************
+* FILENAME :    tiledeltastore.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TileDeltaStore keeps the undo history of an image stored as a
+*       TiledImage. For each edit only the tiles that the edit changed are
+*       kept, compressed losslessly, so that the history of a very large
+*       image costs a fraction of a copy of the image per step. Once the
+*       compressed history exceeds its memory budget the oldest steps are
+*       spilled to a scratch file.
+*
+* NOTES :
+*       Tiles are compressed with the PNG encoder of OpenCV (zlib) at its
+*       fastest level, which needs no dependency beyond the OpenCV modules
+*       the core already links. Tiles that do not compress are kept as raw
+*       bytes. If an edit changed the size of the image every tile of the
+*       previous image is kept. The history is a stack; only the newest
+*       step can be restored. The memory budget defaults to 256 MB and can
+*       be set in megabytes with the QCVTOUCHUP_UNDO_MEMORY environment
+*       variable. A TileDeltaStore must only be accessed by one thread at
+*       a time.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TILEDELTASTORE_H
+#define TILEDELTASTORE_H
+
+#include "tiledimage.h"
+#include <opencv2/core.hpp>
+#include <cstdio>
+#include <vector>
+
+class TileDeltaStore
+{
+public:
+    explicit TileDeltaStore(size_t memoryBudget = defaultMemoryBudget());
+    ~TileDeltaStore();
+    void push(TiledImage &before, TiledImage &after);
+    void restore(TiledImage &image);
+    void clear();
+    int count() const;
+    size_t memoryUsed() const;
+    static size_t defaultMemoryBudget();
+
+private:
+    TileDeltaStore(const TileDeltaStore &) = delete;
+    TileDeltaStore &operator=(const TileDeltaStore &) = delete;
+    struct CompressedTile
+    {
+        int index;
+        bool compressed;
+        std::vector<uchar> bytes;
+        size_t length;
+    };
+    struct Delta
+    {
+        cv::Size size;
+        int type;
+        bool onDisk;
+        long long offset;
+        size_t bytes;
+        std::vector<CompressedTile> tiles;
+    };
+    void compress(const cv::Mat &tile, CompressedTile &stored);
+    void decompress(const CompressedTile &stored, const cv::Size &size, int type, cv::Mat &tile);
+    void spillToDisk();
+    int seekScratch(long long offset);
+    std::vector<Delta> deltas_m;
+    std::FILE *scratchFile_m;
+    long long scratchEnd_m;
+    size_t memoryUsed_m;
+    size_t memoryBudget_m;
+    cv::Mat beforeTile_m;
+    cv::Mat afterTile_m;
+};
+
+#endif // TILEDELTASTORE_H
@@ -0,0 +1,362 @@
+/***********************************************************************
+* FILENAME :    tiledimage.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TiledImage stores an image as a grid of fixed size square
+*       tiles so that an image far larger than the available memory can be
+*       edited. Only the most recently used tiles are kept in memory; the
+*       others are paged out to a scratch file and read back in when they
+*       are needed again.
+*
+* NOTES :
+*       Each tile has a fixed offset in the scratch file, so a tile that
+*       is paged out again overwrites its previous copy. Tiles that have
+*       never been written are not stored at all and read back as zero.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "tiledimage.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+// constructor; the budget is never less than what one tile needs so that a tile in use is never paged out
+TiledImage::TiledImage(size_t memoryBudget, int tileSize)
+{
+    scratchFile_m = nullptr;
+    type_m = CV_8UC3;
+    tileSize_m = std::max(tileSize, 16);
+    tileColumns_m = 0;
+    tileBytes_m = 0;
+    residentBytes_m = 0;
+    memoryBudget_m = memoryBudget;
+}
+
+// destructor closes, and therefore removes, the scratch file
+TiledImage::~TiledImage()
+{
+    release();
+}
+
+/* Returns the memory budget used when none is passed to the constructor. It can be set in megabytes
+ * through the QCVTOUCHUP_TILE_MEMORY environment variable, otherwise 512 MB is used.*/
+size_t TiledImage::defaultMemoryBudget()
+{
+    const char *megabytes = std::getenv("QCVTOUCHUP_TILE_MEMORY");
+    if(megabytes && std::atoi(megabytes) > 0)
+        return static_cast<size_t>(std::atoi(megabytes)) << 20;
+    return static_cast<size_t>(512) << 20;
+}
+
+/* Discards the current image and creates an image of the given size and type. No memory is allocated
+ * for the tiles until they are written to or read from.*/
+void TiledImage::create(const cv::Size &size, int type)
+{
+    release();
+    size_m = size;
+    type_m = type;
+    tileColumns_m = (size.width + tileSize_m - 1) / tileSize_m;
+    int tileRows = (size.height + tileSize_m - 1) / tileSize_m;
+    tileBytes_m = static_cast<size_t>(tileSize_m) * tileSize_m * CV_ELEM_SIZE(type);
+    memoryBudget_m = std::max(memoryBudget_m, tileBytes_m);
+
+    Tile empty;
+    empty.onDisk = false;
+    empty.dirty = false;
+    empty.recent = recentTiles_m.end();
+    tiles_m.assign(static_cast<size_t>(tileColumns_m) * tileRows, empty);
+}
+
+// Copies the image into tiles. The source image can be released afterwards to free its memory.
+void TiledImage::fromMat(const cv::Mat &image)
+{
+    create(image.size(), image.type());
+    for(int i = 0; i < tileCount(); i++)
+    {
+        cv::Rect region = tileRect(i);
+        cv::Mat(image, region).copyTo(tile(i, true));
+    }
+}
+
+// Assembles the whole image into dst. dst must fit in memory.
+void TiledImage::toMat(cv::Mat &dst)
+{
+    dst.create(size_m, type_m);
+    for(int i = 0; i < tileCount(); i++)
+    {
+        cv::Rect region = tileRect(i);
+        tile(i, false).copyTo(dst(region));
+    }
+}
+
+/* Assembles the whole image reduced to the given size into dst, one tile at a time, so that an image
+ * larger than memory can be displayed. Each tile is reduced with area interpolation into the pixels
+ * of dst it covers.*/
+void TiledImage::toMat(cv::Mat &dst, const cv::Size &size)
+{
+    if(size == size_m)
+    {
+        toMat(dst);
+        return;
+    }
+
+    dst.create(size, type_m);
+    double scaleX = size.width / static_cast<double>(size_m.width);
+    double scaleY = size.height / static_cast<double>(size_m.height);
+    for(int i = 0; i < tileCount(); i++)
+    {
+        cv::Rect region = tileRect(i);
+        int x1 = cvRound(region.x * scaleX);
+        int y1 = cvRound(region.y * scaleY);
+        int x2 = cvRound((region.x + region.width) * scaleX);
+        int y2 = cvRound((region.y + region.height) * scaleY);
+        if(x2 > x1 && y2 > y1)
+        {
+            cv::Mat reduced = dst(cv::Rect(x1, y1, x2 - x1, y2 - y1));
+            cv::resize(tile(i, false), reduced, reduced.size(), 0, 0, cv::INTER_AREA);
+        }
+    }
+}
+
+/* Copies the region of the image into dst. The region may extend past the edges of the image, in which
+ * case the missing pixels are filled according to borderType the same way OpenCV extrapolates the
+ * border of an image for its filters. This is used to read a tile with the halo a filter or warp needs.*/
+void TiledImage::readRegion(const cv::Rect &region, cv::Mat &dst, int borderType, const cv::Scalar &borderValue)
+{
+    cv::Rect inside = region & cv::Rect(cv::Point(0, 0), size_m);
+    if(inside.area() == 0)
+    {
+        dst.create(region.size(), type_m);
+        dst.setTo(borderValue);
+        return;
+    }
+
+    cv::Mat assembled;
+    if(inside == region)
+    {
+        dst.create(region.size(), type_m);
+        assembled = dst;
+    }
+    else
+    {
+        assembled.create(inside.size(), type_m);
+    }
+
+    //copy the part of each tile the region overlaps
+    int firstColumn = inside.x / tileSize_m;
+    int lastColumn = (inside.x + inside.width - 1) / tileSize_m;
+    int firstRow = inside.y / tileSize_m;
+    int lastRow = (inside.y + inside.height - 1) / tileSize_m;
+    for(int row = firstRow; row <= lastRow; row++)
+    {
+        for(int column = firstColumn; column <= lastColumn; column++)
+        {
+            int index = row * tileColumns_m + column;
+            cv::Rect overlap = tileRect(index) & inside;
+            cv::Mat &pixels = tile(index, false);
+            pixels(overlap - tileRect(index).tl()).copyTo(assembled(overlap - inside.tl()));
+        }
+    }
+
+    if(inside != region)
+    {
+        cv::copyMakeBorder(assembled, dst, inside.y - region.y, region.br().y - inside.br().y,
+                           inside.x - region.x, region.br().x - inside.br().x, borderType, borderValue);
+    }
+}
+
+// Copies src into the image with its top left corner at origin. Any part of src outside of the image is ignored.
+void TiledImage::writeRegion(const cv::Point &origin, const cv::Mat &src)
+{
+    CV_Assert(src.type() == type_m);
+    cv::Rect region(origin, src.size());
+    cv::Rect inside = region & cv::Rect(cv::Point(0, 0), size_m);
+    if(inside.area() == 0)
+        return;
+
+    int firstColumn = inside.x / tileSize_m;
+    int lastColumn = (inside.x + inside.width - 1) / tileSize_m;
+    int firstRow = inside.y / tileSize_m;
+    int lastRow = (inside.y + inside.height - 1) / tileSize_m;
+    for(int row = firstRow; row <= lastRow; row++)
+    {
+        for(int column = firstColumn; column <= lastColumn; column++)
+        {
+            int index = row * tileColumns_m + column;
+            cv::Rect overlap = tileRect(index) & inside;
+            cv::Mat &pixels = tile(index, true);
+            src(overlap - origin).copyTo(pixels(overlap - tileRect(index).tl()));
+        }
+    }
+}
+
+// Exchanges the contents of two images, including their scratch files. Used to commit an edit.
+void TiledImage::swap(TiledImage &other)
+{
+    std::swap(tiles_m, other.tiles_m);
+    std::swap(recentTiles_m, other.recentTiles_m);
+    std::swap(scratchFile_m, other.scratchFile_m);
+    std::swap(size_m, other.size_m);
+    std::swap(type_m, other.type_m);
+    std::swap(tileSize_m, other.tileSize_m);
+    std::swap(tileColumns_m, other.tileColumns_m);
+    std::swap(tileBytes_m, other.tileBytes_m);
+    std::swap(residentBytes_m, other.residentBytes_m);
+    std::swap(memoryBudget_m, other.memoryBudget_m);
+}
+
+// Frees the tiles in memory and removes the scratch file
+void TiledImage::release()
+{
+    tiles_m.clear();
+    recentTiles_m.clear();
+    if(scratchFile_m)
+    {
+        std::fclose(scratchFile_m);
+        scratchFile_m = nullptr;
+    }
+    size_m = cv::Size();
+    tileColumns_m = 0;
+    residentBytes_m = 0;
+}
+
+// true if no image has been created
+bool TiledImage::empty() const
+{
+    return tiles_m.empty();
+}
+
+// size of the whole image
+cv::Size TiledImage::size() const
+{
+    return size_m;
+}
+
+// OpenCV type of the pixels, such as CV_8UC3
+int TiledImage::type() const
+{
+    return type_m;
+}
+
+// number of tiles, ordered left to right then top to bottom
+int TiledImage::tileCount() const
+{
+    return static_cast<int>(tiles_m.size());
+}
+
+// region of the image covered by the tile. Tiles on the right and bottom edges may be smaller than the tile size.
+cv::Rect TiledImage::tileRect(int index) const
+{
+    cv::Rect region((index % tileColumns_m) * tileSize_m, (index / tileColumns_m) * tileSize_m, tileSize_m, tileSize_m);
+    return region & cv::Rect(cv::Point(0, 0), size_m);
+}
+
+/* Returns the pixels of the tile, reading them from the scratch file if they were paged out. The tile
+ * is marked as the most recently used and other tiles are paged out if the memory budget is exceeded.
+ * The reference is only valid until the next call as the tile may then be paged out itself.*/
+cv::Mat &TiledImage::tile(int index, bool forWrite)
+{
+    Tile &current = tiles_m[index];
+    if(current.pixels.empty())
+    {
+        cv::Rect region = tileRect(index);
+        current.pixels.create(region.size(), type_m);
+        if(current.onDisk)
+        {
+            seekTile(index);
+            size_t bytes = current.pixels.total() * current.pixels.elemSize();
+            if(std::fread(current.pixels.data, 1, bytes, scratchFile_m) != bytes)
+                CV_Error(cv::Error::StsError, "Unable to read image tile from the scratch file");
+        }
+        else
+        {
+            current.pixels.setTo(cv::Scalar::all(0));
+        }
+        residentBytes_m += current.pixels.total() * current.pixels.elemSize();
+        current.recent = recentTiles_m.insert(recentTiles_m.end(), index);
+    }
+    else
+    {
+        recentTiles_m.splice(recentTiles_m.end(), recentTiles_m, current.recent);
+    }
+
+    if(forWrite)
+        current.dirty = true;
+    evictTiles();
+    return current.pixels;
+}
+
+/* Pages out the least recently used tiles until the memory budget is met. Only tiles that changed since
+ * they were last paged out are written to the scratch file. The most recently used tile is never paged out.*/
+void TiledImage::evictTiles()
+{
+    while(residentBytes_m > memoryBudget_m && recentTiles_m.size() > 1)
+    {
+        int index = recentTiles_m.front();
+        Tile &oldest = tiles_m[index];
+        size_t bytes = oldest.pixels.total() * oldest.pixels.elemSize();
+        if(oldest.dirty)
+        {
+            if(!scratchFile_m)
+                scratchFile_m = std::tmpfile();
+            if(!scratchFile_m)
+                CV_Error(cv::Error::StsError, "Unable to create the scratch file for image tiles");
+
+            //tiles are always continuous as they are allocated by create()
+            seekTile(index);
+            if(std::fwrite(oldest.pixels.data, 1, bytes, scratchFile_m) != bytes)
+                CV_Error(cv::Error::StsError, "Unable to write image tile to the scratch file");
+            oldest.onDisk = true;
+            oldest.dirty = false;
+        }
+        oldest.pixels.release();
+        oldest.recent = recentTiles_m.end();
+        recentTiles_m.pop_front();
+        residentBytes_m -= bytes;
+    }
+}
+
+// Moves the scratch file position to the fixed offset of the tile. Offsets can exceed 2 GB.
+void TiledImage::seekTile(int index)
+{
+    long long offset = static_cast<long long>(index) * static_cast<long long>(tileBytes_m);
+#ifdef _WIN32
+    int failed = _fseeki64(scratchFile_m, offset, SEEK_SET);
+#else
+    int failed = fseeko(scratchFile_m, static_cast<off_t>(offset), SEEK_SET);
+#endif
+    if(failed)
+        CV_Error(cv::Error::StsError, "Unable to seek in the scratch file for image tiles");
+}
@@ -0,0 +1,114 @@
+/***********************************************************************
+* FILENAME :    tiledimage.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TiledImage stores an image as a grid of fixed size square
+*       tiles so that an image far larger than the available memory can be
+*       edited. Only the most recently used tiles are kept in memory; the
+*       others are paged out to a scratch file and read back in when they
+*       are needed again. Regions of the image are read and written as
+*       plain cv::Mat so that the core processors can operate on them one
+*       tile at a time.
+*
+* NOTES :
+*       The scratch file is created in the system temporary directory and
+*       is removed automatically when the image is released. The amount of
+*       memory held by the tiles is limited to the budget passed to the
+*       constructor; the QCVTOUCHUP_TILE_MEMORY environment variable (in
+*       megabytes) overrides the default budget. A TiledImage must only be
+*       accessed by one thread at a time. Paging failures throw a
+*       cv::Exception like the other core operations.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TILEDIMAGE_H
+#define TILEDIMAGE_H
+
+#include <opencv2/core.hpp>
+#include <cstdio>
+#include <list>
+#include <vector>
+
+class TiledImage
+{
+public:
+    enum
+    {
+        DefaultTileSize = 512
+    };
+    explicit TiledImage(size_t memoryBudget = defaultMemoryBudget(), int tileSize = DefaultTileSize);
+    ~TiledImage();
+    void create(const cv::Size &size, int type);
+    void fromMat(const cv::Mat &image);
+    void toMat(cv::Mat &dst);
+    void toMat(cv::Mat &dst, const cv::Size &size);
+    void readRegion(const cv::Rect &region, cv::Mat &dst, int borderType = cv::BORDER_REFLECT_101,
+                    const cv::Scalar &borderValue = cv::Scalar());
+    void writeRegion(const cv::Point &origin, const cv::Mat &src);
+    void swap(TiledImage &other);
+    void release();
+    bool empty() const;
+    cv::Size size() const;
+    int type() const;
+    int tileCount() const;
+    cv::Rect tileRect(int index) const;
+    static size_t defaultMemoryBudget();
+
+private:
+    TiledImage(const TiledImage &) = delete;
+    TiledImage &operator=(const TiledImage &) = delete;
+    struct Tile
+    {
+        cv::Mat pixels;
+        bool onDisk;
+        bool dirty;
+        std::list<int>::iterator recent;
+    };
+    cv::Mat &tile(int index, bool forWrite);
+    void evictTiles();
+    void seekTile(int index);
+    std::vector<Tile> tiles_m;
+    std::list<int> recentTiles_m;
+    std::FILE *scratchFile_m;
+    cv::Size size_m;
+    int type_m;
+    int tileSize_m;
+    int tileColumns_m;
+    size_t tileBytes_m;
+    size_t residentBytes_m;
+    size_t memoryBudget_m;
+};
+
+#endif // TILEDIMAGE_H
@@ -0,0 +1,238 @@
+/***********************************************************************
+* FILENAME :    tiledprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TiledProcessor applies an EditOperation to a TiledImage one
+*       tile at a time, writing the result to another TiledImage, so that
+*       only a few tiles of an image larger than memory are ever held at
+*       once. It uses the same core processors as the editing workers for
+*       each tile.
+*
+* NOTES :
+*       Filter operations read each tile with a halo of the surrounding
+*       pixels as wide as the filter kernel needs, so the tiles join
+*       without seams. Rotate and Scale map each output tile back to the
+*       region of the source image it samples from and warp only that
+*       region; a right angle rotation has an exact matrix so its tiles are
+*       not blurred. A Flip reads each tile from its mirrored position. The
+*       Canny edge detector is approximated as its hysteresis
+*       can not cross a tile halo. Like the EditProcessor, a
+*       TiledProcessor must not be shared between threads.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "tiledprocessor.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+
+// constructor
+TiledProcessor::TiledProcessor()
+{
+
+}
+
+// Returns the size of the image the operation produces when applied to an image of imageSize.
+cv::Size TiledProcessor::outputSize(const EditOperation &operation, const cv::Size &imageSize)
+{
+    switch (operation.type)
+    {
+    case EditOperation::Rotate:
+    {
+        cv::Size rotatedSize;
+        TransformProcessor::rotationMatrix(imageSize, operation.value, rotatedSize);
+        if(operation.autoCrop)
+            return TransformProcessor::autoCropRegion(imageSize, operation.value).size();
+        return rotatedSize;
+    }
+    case EditOperation::Crop:
+    case EditOperation::Scale:
+        return operation.region.size();
+    default:
+        return imageSize;
+    }
+}
+
+/* Applies the operation to src and stores the result in dst, which is recreated with the size the
+ * operation produces. Edge detection produces a single channel result which is converted back to RGB
+ * so that every tile of dst has the type of src. May throw a cv::Exception if the region of a Crop or
+ * Scale operation is not valid for src or if a tile can not be paged to the scratch file.*/
+void TiledProcessor::apply(const EditOperation &operation, TiledImage &src, TiledImage &dst)
+{
+    dst.create(outputSize(operation, src.size()), src.type());
+
+    switch (operation.type)
+    {
+    case EditOperation::Filter:
+    {
+        //median blur extrapolates the border by replicating it unlike the other filters
+        const int *parameter = operation.filterParameters;
+        int borderType = cv::BORDER_REFLECT_101;
+        if(parameter[FilterProcessor::KernelOperation] == FilterProcessor::SmoothFilter
+                && parameter[FilterProcessor::KernelType] == FilterProcessor::FilterMedian)
+            borderType = cv::BORDER_REPLICATE;
+        applyToTiles(operation, src, dst, FilterProcessor::haloSize(parameter, src.size()), borderType);
+        break;
+    }
+    case EditOperation::Rotate:
+    {
+        cv::Size rotatedSize;
+        cv::Mat matrix = TransformProcessor::rotationMatrix(src.size(), operation.value, rotatedSize);
+        cv::Point offset(0, 0);
+        if(operation.autoCrop)
+            offset = TransformProcessor::autoCropRegion(src.size(), operation.value).tl();
+        warpTiles(src, dst, matrix, offset, cv::BORDER_CONSTANT);
+        break;
+    }
+    case EditOperation::Crop:
+    {
+        if((operation.region & cv::Rect(cv::Point(0, 0), src.size())) != operation.region)
+            CV_Error(cv::Error::StsBadArg, "Crop region is outside of the image");
+        for(int i = 0; i < dst.tileCount(); i++)
+        {
+            cv::Rect region = dst.tileRect(i);
+            src.readRegion(region + operation.region.tl(), srcTile_m);
+            dst.writeRegion(region.tl(), srcTile_m);
+        }
+        break;
+    }
+    case EditOperation::Scale:
+    {
+        /* maps pixel centers the same way as cv::resize with bilinear interpolation, where
+         * x_src = (x_dst + 0.5) / scale - 0.5, and replicates the border as it does*/
+        if(operation.region.width < 1 || operation.region.height < 1)
+            CV_Error(cv::Error::StsBadArg, "Scale size must be at least one pixel");
+        double scaleX = operation.region.width / static_cast<double>(src.size().width);
+        double scaleY = operation.region.height / static_cast<double>(src.size().height);
+        cv::Mat matrix = cv::Mat::zeros(2, 3, CV_64F);
+        matrix.at<double>(0, 0) = scaleX;
+        matrix.at<double>(0, 2) = 0.5 * scaleX - 0.5;
+        matrix.at<double>(1, 1) = scaleY;
+        matrix.at<double>(1, 2) = 0.5 * scaleY - 0.5;
+        warpTiles(src, dst, matrix, cv::Point(0, 0), cv::BORDER_REPLICATE);
+        break;
+    }
+    case EditOperation::Flip:
+    {
+        //each tile is read from the mirrored position and flipped itself
+        for(int i = 0; i < dst.tileCount(); i++)
+        {
+            cv::Rect region = dst.tileRect(i);
+            cv::Rect sourceRegion = region;
+            if(operation.value <= 0)
+                sourceRegion.y = src.size().height - region.y - region.height;
+            if(operation.value != 0)
+                sourceRegion.x = src.size().width - region.x - region.width;
+            src.readRegion(sourceRegion, srcTile_m);
+            processor_m.transform.flip(srcTile_m, dstTile_m, operation.value);
+            dst.writeRegion(region.tl(), dstTile_m);
+        }
+        break;
+    }
+    default: //Adjust, Temperature, and None operate on each pixel independently
+        applyToTiles(operation, src, dst, 0, cv::BORDER_REFLECT_101);
+        break;
+    }
+}
+
+/* Applies an operation that does not change the size of the image to each tile. Each tile is read with
+ * a border of halo pixels which is trimmed from the result before it is written.*/
+void TiledProcessor::applyToTiles(const EditOperation &operation, TiledImage &src, TiledImage &dst, int halo, int borderType)
+{
+    for(int i = 0; i < dst.tileCount(); i++)
+    {
+        cv::Rect region = dst.tileRect(i);
+        cv::Rect haloRegion(region.x - halo, region.y - halo, region.width + 2 * halo, region.height + 2 * halo);
+        src.readRegion(haloRegion, srcTile_m, borderType);
+
+        //filters derive their kernel from the size of the whole image, not the tile
+        if(operation.type == EditOperation::Filter)
+            processor_m.filter.process(srcTile_m, dstTile_m, operation.filterParameters, src.size());
+        else
+            processor_m.apply(operation, srcTile_m, dstTile_m);
+
+        if(dstTile_m.channels() == 1)
+            cv::cvtColor(dstTile_m, dstTile_m, cv::COLOR_GRAY2RGB);
+        dst.writeRegion(region.tl(), dstTile_m(cv::Rect(halo, halo, region.width, region.height)));
+    }
+}
+
+/* Warps src into dst with the forward affine matrix, one output tile at a time. offset is the position of
+ * dst within the warped image, which is not zero when the warped image is cropped. For each output tile
+ * the corners are mapped back into src and only the region they bound, plus a margin for the bilinear
+ * interpolation, is read. The matrix is then translated so it maps that region onto the tile.*/
+void TiledProcessor::warpTiles(TiledImage &src, TiledImage &dst, const cv::Mat &matrix, const cv::Point &offset, int borderType)
+{
+    cv::Mat inverse;
+    cv::invertAffineTransform(matrix, inverse);
+    const double *a = inverse.ptr<double>(0);
+    const double *b = inverse.ptr<double>(1);
+
+    for(int i = 0; i < dst.tileCount(); i++)
+    {
+        cv::Rect region = dst.tileRect(i);
+        double x1 = region.x + offset.x;
+        double y1 = region.y + offset.y;
+        double x2 = x1 + region.width;
+        double y2 = y1 + region.height;
+
+        //bounding box of the tile corners mapped back into the source image
+        double cornersX[4] = {x1, x2, x1, x2};
+        double cornersY[4] = {y1, y1, y2, y2};
+        double minX = 0, minY = 0, maxX = 0, maxY = 0;
+        for(int j = 0; j < 4; j++)
+        {
+            double x = a[0] * cornersX[j] + a[1] * cornersY[j] + a[2];
+            double y = b[0] * cornersX[j] + b[1] * cornersY[j] + b[2];
+            minX = j ? std::min(minX, x) : x;
+            maxX = j ? std::max(maxX, x) : x;
+            minY = j ? std::min(minY, y) : y;
+            maxY = j ? std::max(maxY, y) : y;
+        }
+        cv::Rect sourceRegion(cvFloor(minX) - 2, cvFloor(minY) - 2,
+                              cvCeil(maxX) - cvFloor(minX) + 4, cvCeil(maxY) - cvFloor(minY) + 4);
+        src.readRegion(sourceRegion, srcTile_m, borderType);
+
+        //dst - tile = A * (src' + sourceRegion) + t - tile
+        cv::Mat tileMatrix = matrix.clone();
+        double *row0 = tileMatrix.ptr<double>(0);
+        double *row1 = tileMatrix.ptr<double>(1);
+        row0[2] += row0[0] * sourceRegion.x + row0[1] * sourceRegion.y - x1;
+        row1[2] += row1[0] * sourceRegion.x + row1[1] * sourceRegion.y - y1;
+
+        cv::warpAffine(srcTile_m, dstTile_m, tileMatrix, region.size(), cv::INTER_LINEAR, borderType);
+        dst.writeRegion(region.tl(), dstTile_m);
+    }
+}
@@ -0,0 +1,76 @@
+/***********************************************************************
+* FILENAME :    tiledprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TiledProcessor applies an EditOperation to a TiledImage one
+*       tile at a time, writing the result to another TiledImage, so that
+*       only a few tiles of an image larger than memory are ever held at
+*       once. It uses the same core processors as the editing workers for
+*       each tile.
+*
+* NOTES :
+*       Filter operations read each tile with a halo of the surrounding
+*       pixels as wide as the filter kernel needs, so the tiles join
+*       without seams. Rotate and Scale map each output tile back to the
+*       region of the source image it samples from and warp only that
+*       region. The Canny edge detector is approximated as its hysteresis
+*       can not cross a tile halo. Like the EditProcessor, a
+*       TiledProcessor must not be shared between threads.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TILEDPROCESSOR_H
+#define TILEDPROCESSOR_H
+
+#include "editprocessor.h"
+#include "tiledimage.h"
+#include <opencv2/core.hpp>
+
+class TiledProcessor
+{
+public:
+    TiledProcessor();
+    void apply(const EditOperation &operation, TiledImage &src, TiledImage &dst);
+    static cv::Size outputSize(const EditOperation &operation, const cv::Size &imageSize);
+
+private:
+    void applyToTiles(const EditOperation &operation, TiledImage &src, TiledImage &dst, int halo, int borderType);
+    void warpTiles(TiledImage &src, TiledImage &dst, const cv::Mat &matrix, const cv::Point &offset, int borderType);
+    EditProcessor processor_m;
+    cv::Mat srcTile_m;
+    cv::Mat dstTile_m;
+};
+
+#endif // TILEDPROCESSOR_H
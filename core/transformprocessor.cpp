@@ -0,0 +1,336 @@
+/***********************************************************************
+* FILENAME :    transformprocessor.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TransformProcessor performs the geometric operations for the
+*       image such as cropping, rotating, and scaling. It takes a plain
+*       cv::Mat in and writes a plain cv::Mat out so it can be used by the
+*       TransformWorker, the batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       The operations may throw a cv::Exception if passed a region or
+*       size that is invalid for the source image. The caller is
+*       responsible for catching the exception and reporting it. The
+*       operations were moved here from transformworker.cpp.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "transformprocessor.h"
+#include "stageprofiler.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    //a pixel of N bytes, copied as one value
+    template<int N>
+    struct PixelBytes
+    {
+        uchar value[N];
+    };
+
+    /* Copies each pixel of dst from the pixel of src given by an integer mapping, where for the pixel (x, y) of
+     * dst the source row is map[0] + map[1] * y + map[2] * x and the source column is map[3] + map[4] * y +
+     * map[5] * x. dst is visited in square blocks so that a transposing map reads src a few cache lines at a
+     * time. Each call of the body copies a range of block rows.*/
+    template<typename Pixel>
+    class OrientedCopier : public cv::ParallelLoopBody
+    {
+    public:
+        OrientedCopier(const cv::Mat &src, cv::Mat &dst, const int *map) : src_m(src), dst_m(dst), map_m(map) {}
+
+        void operator()(const cv::Range &range) const override
+        {
+            const std::ptrdiff_t stride = map_m[2] * static_cast<std::ptrdiff_t>(src_m.step)
+                    + map_m[5] * static_cast<std::ptrdiff_t>(sizeof(Pixel));
+            for(int block = range.start; block < range.end; block++)
+            {
+                int y0 = block * TRANSFORM_BLOCK_SIZE;
+                int y1 = std::min(y0 + TRANSFORM_BLOCK_SIZE, dst_m.rows);
+                for(int x0 = 0; x0 < dst_m.cols; x0 += TRANSFORM_BLOCK_SIZE)
+                {
+                    int x1 = std::min(x0 + TRANSFORM_BLOCK_SIZE, dst_m.cols);
+                    for(int y = y0; y < y1; y++)
+                    {
+                        Pixel *out = dst_m.ptr<Pixel>(y);
+                        int row = map_m[0] + map_m[1] * y + map_m[2] * x0;
+                        int col = map_m[3] + map_m[4] * y + map_m[5] * x0;
+                        const uchar *in = src_m.ptr<uchar>(row) + col * sizeof(Pixel);
+                        for(int x = x0; x < x1; x++, in += stride)
+                            out[x] = *reinterpret_cast<const Pixel*>(in);
+                    }
+                }
+            }
+        }
+
+    private:
+        const cv::Mat &src_m;
+        cv::Mat &dst_m;
+        const int *map_m;
+    };
+}
+
+// constructor
+TransformProcessor::TransformProcessor()
+{
+
+}
+
+/* Crops the image by assigning the region of src to dst. The region is assumed to already be in
+ * bounds. No pixel data is copied; dst shares the buffer of src.*/
+void TransformProcessor::crop(const cv::Mat &src, cv::Mat &dst, const cv::Rect &region)
+{
+    StageTimer stage("transform");
+    dst = cv::Mat(src, region);
+    stage.lap("crop");
+}
+
+/* Computes the matrix used to rotate an image of the given size by the number of degrees passed to it. The
+ * matrix is adjusted so that the rotated image is centered in the rectangular boundary of the rotated region,
+ * the size of which is stored in rotatedSize. This is the forward mapping from source to rotated pixels.*/
+cv::Mat TransformProcessor::rotationMatrix(const cv::Size &image, int degree, cv::Size &rotatedSize)
+{
+    //right angles map pixel centers onto pixel centers exactly
+    int turns = quarterTurns(degree);
+    if(turns >= 0)
+    {
+        const double width = image.width - 1, height = image.height - 1;
+        const double matrices[4][6] = {
+            { 1,  0, 0,      0,  1, 0},
+            { 0, -1, height, 1,  0, 0},
+            {-1,  0, width,  0, -1, height},
+            { 0,  1, 0,     -1,  0, width}
+        };
+        rotatedSize = turns % 2 ? cv::Size(image.height, image.width) : image;
+        return cv::Mat(2, 3, CV_64F, const_cast<double*>(matrices[turns])).clone();
+    }
+
+    //center of rotation, rotation matrix, and containing size for rotation
+    degree *= -1;
+    cv::Point2f center = cv::Point2f((image.width -1) / 2.0, (image.height -1) / 2.0);
+    cv::Mat rotationMatrix = cv::getRotationMatrix2D(center, degree, 1);
+    cv::Rect boundingRegion = cv::RotatedRect(center, image, degree).boundingRect();
+
+    //adjust the rotation matrix
+    rotationMatrix.at<double>(0, 2) += boundingRegion.width / 2.0 - image.width / 2.0;
+    rotationMatrix.at<double>(1, 2) += boundingRegion.height / 2.0 - image.height / 2.0;
+    rotatedSize = boundingRegion.size();
+    return rotationMatrix;
+}
+
+/* Computes the region of the rotated image (see rotationMatrix) that the auto crop keeps. This is the largest
+ * axis aligned rectangle inscribed in the rotated image, found analytically: if the shorter side is small
+ * enough that the rectangle touches both long edges it is half the shorter side from the center to each of
+ * them, otherwise each of its corners touches a side of the rotated image. The region is centered in the
+ * rotated image and one pixel is left at each edge so that no pixel blended with the black corners by the
+ * interpolation is kept. If the rotation leaves no black corners the whole rotated image is returned.*/
+cv::Rect TransformProcessor::autoCropRegion(const cv::Size &image, int degree)
+{
+    int turns = quarterTurns(degree);
+    if(turns >= 0)
+        return cv::Rect(0, 0, turns % 2 ? image.height : image.width, turns % 2 ? image.width : image.height);
+
+    cv::Size rotatedSize;
+    rotationMatrix(image, degree, rotatedSize);
+
+    double radians = degree * CV_PI / 180.0;
+    double sinA = std::fabs(std::sin(radians));
+    double cosA = std::fabs(std::cos(radians));
+    bool widthIsLonger = image.width >= image.height;
+    double longSide = widthIsLonger ? image.width : image.height;
+    double shortSide = widthIsLonger ? image.height : image.width;
+
+    double width, height;
+    if(shortSide <= 2.0 * sinA * cosA * longSide || std::fabs(sinA - cosA) < 1e-10)
+    {
+        //half constrained, two corners of the rectangle touch the longer sides
+        double half = 0.5 * shortSide;
+        width = widthIsLonger ? half / sinA : half / cosA;
+        height = widthIsLonger ? half / cosA : half / sinA;
+    }
+    else
+    {
+        //fully constrained, each corner of the rectangle touches a side
+        double cos2A = cosA * cosA - sinA * sinA;
+        width = (image.width * cosA - image.height * sinA) / cos2A;
+        height = (image.height * cosA - image.width * sinA) / cos2A;
+    }
+
+    int cropWidth = std::max(1, std::min(rotatedSize.width, static_cast<int>(width) - 2));
+    int cropHeight = std::max(1, std::min(rotatedSize.height, static_cast<int>(height) - 2));
+    return cv::Rect((rotatedSize.width - cropWidth) / 2, (rotatedSize.height - cropHeight) / 2, cropWidth, cropHeight);
+}
+
+/* Performs the rotation computation on the image. It is passed a value that represents the number
+ * of degrees to rotate the image. After the image is rotated using an adjusted rotation matrix, the
+ * new image is warped to fit inside the rectangular boundary of the rotated region. If autoCrop is
+ * true only the region computed by autoCropRegion is warped. A multiple of
+ * 90 degrees is instead copied pixel for pixel by copyOriented.
+ * Returns false, leaving dst unchanged, if the work was abandoned by the cancel check.*/
+bool TransformProcessor::rotate(const cv::Mat &src, cv::Mat &dst, int degree, bool autoCrop)
+{
+    StageTimer stage("transform");
+
+    //right angles leave no corners to crop and are copied exactly
+    int turns = quarterTurns(degree);
+    if(turns >= 0)
+    {
+        const int rows = src.rows - 1, cols = src.cols - 1;
+        const int maps[4][6] = {
+            {0,     1,  0, 0,     0,  1},
+            {rows,  0, -1, 0,     1,  0},
+            {rows, -1,  0, cols,  0, -1},
+            {0,     0,  1, cols, -1,  0}
+        };
+        copyOriented(src, dst, turns % 2 ? cv::Size(src.rows, src.cols) : src.size(), maps[turns]);
+        stage.lap("right angle rotate");
+        return true;
+    }
+
+    //clone necessary because internal checks will prevent GUI image from cycling.
+    src.copyTo(implicitOclImage_m);
+    stage.lap("copy to UMat");
+    if(isCancelled()) return false;
+
+    cv::Size rotatedSize;
+    cv::Mat matrix = rotationMatrix(src.size(), degree, rotatedSize);
+
+    //to crop, the matrix is shifted so that only the region kept is warped, straight into a buffer of its size
+    cv::Size outputSize = rotatedSize;
+    if(autoCrop)
+    {
+        cv::Rect cropRegion = autoCropRegion(src.size(), degree);
+        matrix.at<double>(0, 2) -= cropRegion.x;
+        matrix.at<double>(1, 2) -= cropRegion.y;
+        outputSize = cropRegion.size();
+    }
+
+    cv::UMat(outputSize, src.type()).copyTo(previewImplicitOclImage_m);
+    cv::warpAffine(implicitOclImage_m, previewImplicitOclImage_m, matrix, outputSize);
+    stage.lap("warpAffine");
+    if(isCancelled()) return false;
+
+    //after computation is complete, push image
+    previewImplicitOclImage_m.copyTo(dst);
+    stage.lap("copy to preview");
+    return true;
+}
+
+//performs a resize operation to the exact size given using bilinear interpolation
+void TransformProcessor::scale(const cv::Mat &src, cv::Mat &dst, const cv::Size &size)
+{
+    StageTimer stage("transform");
+    cv::resize(src, dst, size, 0, 0, cv::INTER_LINEAR);
+    stage.lap("resize");
+}
+
+/* Mirrors src into dst using the flipCode convention of cv::flip: 0 flips the rows (vertically), a positive
+ * value flips the columns (horizontally), and a negative value flips both, which is the same as turning the
+ * image 180 degrees.*/
+void TransformProcessor::flip(const cv::Mat &src, cv::Mat &dst, int flipCode)
+{
+    StageTimer stage("transform");
+    const int rows = src.rows - 1, cols = src.cols - 1;
+    const int vertical[6] = {rows, -1, 0, 0, 0, 1};
+    const int horizontal[6] = {0, 1, 0, cols, 0, -1};
+    const int both[6] = {rows, -1, 0, cols, 0, -1};
+    copyOriented(src, dst, src.size(), flipCode == 0 ? vertical : flipCode > 0 ? horizontal : both);
+    stage.lap("flip");
+}
+
+/* Returns the number of clockwise quarter turns (0 to 3) that rotating by degree is equal to, or -1 if
+ * degree is not a multiple of 90.*/
+int TransformProcessor::quarterTurns(int degree)
+{
+    degree = ((degree % 360) + 360) % 360;
+    return degree % 90 == 0 ? degree / 90 : -1;
+}
+
+/* Copies src into dst, created with the given size, through the integer pixel mapping described by
+ * OrientedCopier. The blocks of rows are spread across threads. If dst shares the buffer of src (as after a
+ * crop or when called in place) src is copied first so that no pixel is read after it is overwritten.*/
+void TransformProcessor::copyOriented(const cv::Mat &src, cv::Mat &dst, const cv::Size &size, const int *map)
+{
+    cv::Mat source = src;
+    if(dst.data != nullptr && dst.datastart == src.datastart)
+        source = src.clone();
+
+    dst.create(size, src.type());
+    cv::Range blocks(0, (size.height + TRANSFORM_BLOCK_SIZE - 1) / TRANSFORM_BLOCK_SIZE);
+    switch (src.elemSize())
+    {
+    case 1:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<1> >(source, dst, map));
+        break;
+    case 2:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<2> >(source, dst, map));
+        break;
+    case 3:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<3> >(source, dst, map));
+        break;
+    case 4:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<4> >(source, dst, map));
+        break;
+    case 6:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<6> >(source, dst, map));
+        break;
+    case 8:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<8> >(source, dst, map));
+        break;
+    case 12:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<12> >(source, dst, map));
+        break;
+    case 16:
+        cv::parallel_for_(blocks, OrientedCopier<PixelBytes<16> >(source, dst, map));
+        break;
+    default:
+        CV_Error(cv::Error::StsBadArg, "Unsupported pixel size for an exact rotation or flip");
+    }
+}
+
+/* Sets a function that is called between the stages of rotate. If it returns true the remaining stages
+ * are skipped, which lets a caller abandon work whose result is no longer wanted. An empty function
+ * (the default) always lets the work run to completion.*/
+void TransformProcessor::setCancelCheck(const std::function<bool()> &cancelCheck)
+{
+    cancelCheck_m = cancelCheck;
+}
+
+// Returns true if the cancel check is set and reports the work in progress is no longer wanted
+bool TransformProcessor::isCancelled() const
+{
+    return cancelCheck_m && cancelCheck_m();
+}
@@ -0,0 +1,83 @@
+/***********************************************************************
+* FILENAME :    transformprocessor.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TransformProcessor performs the geometric operations for the
+*       image such as cropping, rotating, flipping, and scaling. It takes a plain
+*       cv::Mat in and writes a plain cv::Mat out so it can be used by the
+*       TransformWorker, the batch mode, and the benchmarks alike.
+*
+* NOTES :
+*       The operations may throw a cv::Exception if passed a region or
+*       size that is invalid for the source image. The caller is
+*       responsible for catching the exception and reporting it. The
+*       operations were moved here from transformworker.cpp. Rotations by
+*       a multiple of 90 degrees and flips move whole pixels, so they are
+*       copied exactly (no interpolation) in cache sized blocks spread
+*       across threads instead of being passed through warpAffine.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TRANSFORMPROCESSOR_H
+#define TRANSFORMPROCESSOR_H
+
+#include <opencv2/core.hpp>
+#include <functional>
+
+//side of the square blocks of pixels copied at a time by the right angle rotations and flips
+#define TRANSFORM_BLOCK_SIZE 64
+
+class TransformProcessor
+{
+public:
+    TransformProcessor();
+    void crop(const cv::Mat &src, cv::Mat &dst, const cv::Rect &region);
+    bool rotate(const cv::Mat &src, cv::Mat &dst, int degree, bool autoCrop);
+    void setCancelCheck(const std::function<bool()> &cancelCheck);
+    void scale(const cv::Mat &src, cv::Mat &dst, const cv::Size &size);
+    void flip(const cv::Mat &src, cv::Mat &dst, int flipCode);
+    static int quarterTurns(int degree);
+    static cv::Mat rotationMatrix(const cv::Size &image, int degree, cv::Size &rotatedSize);
+    static cv::Rect autoCropRegion(const cv::Size &image, int degree);
+
+private:
+    bool isCancelled() const;
+    static void copyOriented(const cv::Mat &src, cv::Mat &dst, const cv::Size &size, const int *map);
+    std::function<bool()> cancelCheck_m;
+    cv::UMat implicitOclImage_m;
+    cv::UMat previewImplicitOclImage_m;
+};
+
+#endif // TRANSFORMPROCESSOR_H
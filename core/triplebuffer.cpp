@@ -0,0 +1,101 @@
+/***********************************************************************
+* FILENAME :    triplebuffer.cpp
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TripleBuffer hands images from one thread to another without a
+*       lock. The producer renders into the write buffer and publishes it
+*       with an atomic swap, and the consumer acquires the latest
+*       published image whenever it is ready to use one.
+*
+* NOTES :
+*       See triplebuffer.h
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#include "triplebuffer.h"
+
+//the middle index carries this bit while it holds a frame the consumer has not acquired
+#define TRIPLE_BUFFER_FRESH 4
+#define TRIPLE_BUFFER_INDEX 3
+
+// The producer starts with the first buffer, the consumer with the last, and the middle is exchanged
+TripleBuffer::TripleBuffer()
+    : operations_m(), middle_m(1), write_m(0), read_m(2)
+{
+}
+
+/* Returns the buffer the producer renders the next frame into. It may hold a frame published earlier
+ * and be written to in place, unless its data is still shared by another image in which case it is
+ * released first so that the other image is not changed.*/
+cv::Mat &TripleBuffer::writeBuffer()
+{
+    cv::Mat &buffer = buffers_m[write_m];
+    if(buffer.u && buffer.u->refcount > 1)
+        buffer.release();
+    return buffer;
+}
+
+/* Publishes the write buffer as the latest frame by swapping it with the middle buffer. The producer
+ * continues with the buffer it received, which is either free or a frame the consumer skipped. operation
+ * is the edit the frame is the exact result of; the default (None) marks the frame as not exact.*/
+void TripleBuffer::publish(const EditOperation &operation)
+{
+    operations_m[write_m] = operation;
+    int previous = middle_m.exchange(write_m | TRIPLE_BUFFER_FRESH, std::memory_order_acq_rel);
+    write_m = previous & TRIPLE_BUFFER_INDEX;
+}
+
+/* Makes the latest published frame the read buffer by swapping it with the middle buffer. Returns true
+ * if there was a new frame, else false and the read buffer still holds the last frame acquired.*/
+bool TripleBuffer::acquire()
+{
+    if(!(middle_m.load(std::memory_order_acquire) & TRIPLE_BUFFER_FRESH))
+        return false;
+    int previous = middle_m.exchange(read_m, std::memory_order_acq_rel);
+    read_m = previous & TRIPLE_BUFFER_INDEX;
+    return true;
+}
+
+// Returns the frame last acquired by the consumer. It is not changed until the next acquire.
+const cv::Mat &TripleBuffer::readBuffer() const
+{
+    return buffers_m[read_m];
+}
+
+// Returns the operation the frame last acquired by the consumer was published with.
+const EditOperation &TripleBuffer::readOperation() const
+{
+    return operations_m[read_m];
+}
@@ -0,0 +1,87 @@
+/***********************************************************************
+* FILENAME :    triplebuffer.h
+*
+* LICENSE:
+*       qcvTouchUp provides an image processing toolset for editing
+*       photographs, purposed and packaged for use in a desktop application
+*       user environment. Copyright (C) 2018,  Matthew R. Miller
+*
+*       This program is free software: you can redistribute it and/or modify
+*       it under the terms of the GNU General Public License as published by
+*       the Free Software Foundation (version 3 of the License).
+*
+*       The framework and libraries used to create this software are licenced
+*       under the  GNU Lesser General Public License (LGPL) version 3 and the
+*       3-clause BSD License as agreed upon through the use of the Qt toolkit
+*       and OpenCV libraries respectively. Copies of the appropriate licenses
+*       for qcvTouchup, and its source code, can be found in LICENSE.txt,
+*       LICENSE.Qt.txt, and LICENSE.CV.txt. If not, please see
+*       <http://www.gnu.org/licenses/> and <https://opencv.org/license.html>
+*       for further information on licensing.
+*
+*       This program is distributed in the hope that it will be useful,
+*       but WITHOUT ANY WARRANTY; without even the implied warranty of
+*       MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*       GNU General Public License for more details.
+*
+*       If you wish to contact the developer about this project, please do so
+*       through their account at <https://github.com/mattrussmill>
+*
+* DESCRIPTION :
+*       The TripleBuffer hands images from one thread to another without a
+*       lock. The producer renders into the write buffer and publishes it
+*       with an atomic swap, and the consumer acquires the latest
+*       published image whenever it is ready to use one. Frames published
+*       faster than they are consumed are skipped, so the consumer always
+*       sees the newest complete image and neither thread ever waits on
+*       the other.
+*
+* NOTES :
+*       A TripleBuffer must have exactly one producer thread and one
+*       consumer thread. Each side owns one of the three buffers; the
+*       third is exchanged between them through a single atomic index. The
+*       write buffer is released before it is reused if its data is still
+*       shared (e.g. the consumer adopted the frame, or a crop left a view
+*       into another image), so a published frame is never written to in
+*       place. Assigning an image to the write buffer only shares its
+*       data, so it must not be changed after it is published. Each frame
+*       is published with the EditOperation it is the exact result of, or
+*       an operation of type None if it is not (e.g. an approximation), so
+*       the consumer knows whether the frame can be kept as the result.
+*
+* AUTHOR :  agent                   START DATE :    October 10/16/2026
+*
+* CHANGES : N/A - N/A
+*
+* VERSION       DATE            WHO                     DETAIL
+* 0.1           10/16/2026      agent                   Initial Rev
+*
+************************************************************************/
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <opencv2/core.hpp>
+#include <atomic>
+#include "editprocessor.h"
+
+class TripleBuffer
+{
+public:
+    TripleBuffer();
+    cv::Mat &writeBuffer();
+    void publish(const EditOperation &operation = EditOperation());
+    bool acquire();
+    const cv::Mat &readBuffer() const;
+    const EditOperation &readOperation() const;
+
+private:
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer &operator=(const TripleBuffer&) = delete;
+    cv::Mat buffers_m[3];
+    EditOperation operations_m[3];
+    std::atomic<int> middle_m;
+    int write_m;
+    int read_m;
+};
+
+#endif // TRIPLEBUFFER_H
@@ -48,28 +48,25 @@
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           04/18/2018      Matthew R. Miller       Initial Rev
 * 0.2           03/04/2019      Matthew R. Miller       Individ worker for menu
+* 0.3           10/16/2026      agent                   Proxy Preview, Kept Worker
 ************************************************************************/
 #include "adjustmenu.h"
 #include "ui_adjustmenu.h"
 #include "../workers/adjustworker.h"
 #include "../../app_filters/mousewheeleatereventfilter.h"
 #include <cmath>
-#include <QMutex>
-#include <QByteArray>
 #include <QShowEvent>
 #include <QPainter>
 #include <QDebug>
 
 //Constructor initializes all members, installs event filters, and connects necessary signals / slots.
-AdjustMenu::AdjustMenu(QMutex *mutex, QWidget *parent) :
+AdjustMenu::AdjustMenu(QWidget *parent) :
     QScrollArea(parent),
     ui(new Ui::AdjustMenu)
 {
     ui->setupUi(this);
-    masterImage_m = nullptr;
-    previewImage_m = nullptr;
-    workerMutex_m = mutex;
     adjustWorker_m = nullptr;
+    workerReady_m = false;
 
     MouseWheelEaterEventFilter *wheelFilter = new MouseWheelEaterEventFilter(this);
     ui->horizontalSlider_Brightness->installEventFilter(wheelFilter);
@@ -101,27 +98,66 @@ AdjustMenu::AdjustMenu(QMutex *mutex, QWidget *parent) :
 // destructor
 AdjustMenu::~AdjustMenu()
 {
-    //end worker thread once event loop finishes
-    if(adjustWorker_m)
-    {
-        worker_m.terminate();
-        worker_m.wait();
-        delete adjustWorker_m; //safe? Different way to handle this?
-        adjustWorker_m = nullptr;
-    }
+    //end worker thread once event loop finishes, the worker is deleted as the thread finishes
+    worker_m.quit();
+    worker_m.wait();
+    adjustWorker_m = nullptr;
 
     delete ui;
 }
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the parent object. If the Mat's become empty in the parent object this slot
- * should be signaled with nullptrs to signify they are empty. */
-void AdjustMenu::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
+/* This slot publishes the image the worker renders the previews from. The image is shared with the
+ * parent object, which must not write to it afterwards, and is empty if no image is open. The worker
+ * acquires it the next time it renders, so no lock is held by either thread.*/
+void AdjustMenu::receiveSourceImage(const cv::Mat &image)
 {
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Adjust Menu Images:" << masterImage_m << previewImage_m;
-    emit distributeImageBufferAddresses(masterImage, previewImage);
+    sourceFrames_m.writeBuffer() = image;
+    sourceFrames_m.publish();
+    sourceFrames_m.writeBuffer().release();
+}
+
+/* Returns the frames the worker publishes its previews to. Only the GUI thread may acquire them and
+ * the latest frame remains in the read buffer until the next one is acquired.*/
+TripleBuffer *AdjustMenu::previewFrames()
+{
+    return &previewFrames_m;
+}
+
+/* Returns true once the worker has finished its start up, including the OpenCL warm-up of its
+ * processor, and renders previews without an initial delay.*/
+bool AdjustMenu::isWorkerReady() const
+{
+    return workerReady_m;
+}
+
+/* Returns the adjustment last sent to the worker so that it can be rendered again at a different
+ * resolution (e.g. at full resolution when a proxy preview is applied).*/
+EditOperation AdjustMenu::editOperation() const
+{
+    EditOperation operation{};
+    operation.type = EditOperation::Adjust;
+    for(int i = 0; i < AdjustProcessor::ParameterCount; i++)
+        operation.adjustParameters[i] = sliderValues_m[i];
+    return operation;
+}
+
+/* Returns the operation of the menu when its sliders are initialized. Every value leaves the image unchanged,
+ * so an operation equal to it does not need to be applied.*/
+EditOperation AdjustMenu::defaultOperation() const
+{
+    EditOperation operation{};
+    operation.type = EditOperation::Adjust;
+    operation.adjustParameters[Brightness] = 0.0f;
+    operation.adjustParameters[Contrast] = 1.0f;
+    operation.adjustParameters[Depth] = 255.0f;
+    operation.adjustParameters[Hue] = 0.0f;
+    operation.adjustParameters[Saturation] = 0.0f;
+    operation.adjustParameters[Intensity] = 0.0f;
+    operation.adjustParameters[Gamma] = 1.0f;
+    operation.adjustParameters[Highlight] = 0.0f;
+    operation.adjustParameters[Shadows] = 0.0f;
+    operation.adjustParameters[Color] = 1.0f;
+    return operation;
 }
 
 // Enables or disables tracking for the appropriate menu widgets
@@ -183,16 +219,9 @@ void AdjustMenu::initializeSliders()
     ui->radioButton_Grayscale->blockSignals(false);
 
     //Set initial parameter array for sliders
-    sliderValues_m[Brightness] = 0.0; //cast to byte array so can be transferred via QVariant
-    sliderValues_m[Contrast] = 1.0;
-    sliderValues_m[Depth] = 255.0;
-    sliderValues_m[Hue] = 0.0;
-    sliderValues_m[Saturation] = 0.0;
-    sliderValues_m[Intensity] = 0.0;
-    sliderValues_m[Gamma] = 1.0;
-    sliderValues_m[Highlight] = 1.0;
-    sliderValues_m[Shadows] = 1.0;
-    sliderValues_m[Color] = 1.0;
+    EditOperation operation = defaultOperation();
+    for(int i = 0; i < AdjustProcessor::ParameterCount; i++)
+        sliderValues_m[i] = operation.adjustParameters[i];
 }
 
 /* Slot signals contrast worker when triggered. When working with images represented by 8-bits per channel,
@@ -203,7 +232,7 @@ void AdjustMenu::changeContrastValue(int value)
     //if > 1, increase range from 1 to 2.4 while keeping 1 the slider center point by using log10
     if(value > 100) value *= log10(value / 10.0);
     sliderValues_m[Contrast] = value / 100.0;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts brightness slider when triggered for RGB values. It adjusts the sliders
@@ -212,14 +241,14 @@ void AdjustMenu::changeContrastValue(int value)
 void AdjustMenu::changeBrightnessValue(int value)
 {
     sliderValues_m[Brightness] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts the number of intensity values per channel allotted in the image from 0 to 255.*/
 void AdjustMenu::changeDepthValue(int value)
 {
     sliderValues_m[Depth] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts hue slider when triggered for HLS values. It shifts the hue value from the sliders
@@ -228,7 +257,7 @@ void AdjustMenu::changeDepthValue(int value)
 void AdjustMenu::changeHueValue(int value)
 {
     sliderValues_m[Hue] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts saturation slider when triggered for HLS values. It adjusts the sliders
@@ -237,7 +266,7 @@ void AdjustMenu::changeHueValue(int value)
 void AdjustMenu::changeSaturationValue(int value)
 {
     sliderValues_m[Saturation] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts intensity (or lightness) slider when triggered for HLS values. It adjusts the sliders
@@ -246,21 +275,21 @@ void AdjustMenu::changeSaturationValue(int value)
 void AdjustMenu::changeIntensityValue(int value)
 {
     sliderValues_m[Intensity] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 //Sets radio button to generate a color image
 void AdjustMenu::changeToColorImage()
 {
     sliderValues_m[Color] = 1.0;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 //Sets radio button to generate a grayscale image
 void AdjustMenu::changeToGrayscaleImage()
 {
     sliderValues_m[Color] = -1.0;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot adjusts gamma over the whole range of intensities in the image. It adjusts the sliders between -100 and 100.
@@ -272,21 +301,21 @@ void AdjustMenu::changeGammaValue(int value)
         sliderValues_m[Gamma] = (value / 150.0) + 1;
     else
         sliderValues_m[Gamma] = (value / 50.0) + 1;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot shifts the gamma adjustment plot vertically between 80 and -80 for values affected between 149 and 255*/
 void AdjustMenu::changeHighlightsValue(int value)
 {
     sliderValues_m[Highlight] = value; //should use highlight method with equations provided
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 /* Slot shifts the gamma adjustment plot vertically between 80 and -80 for values affected between 0 and 106*/
 void AdjustMenu::changeShadowsValue(int value)
 {
     sliderValues_m[Shadows] = value;
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&sliderValues_m), sizeof(float) * 10));
+    workSignalSuppressor.receiveNewData(sliderValues_m);
 }
 
 //overloads setVisible to signal the worker thread to be managed correctly
@@ -303,52 +332,38 @@ void AdjustMenu::showEvent(QShowEvent *event)
     QWidget::showEvent(event);
 }
 
-/* This method determines when the worker thread should be created or destroyed so
- * that the worker thread (with event loop) is only running if it is required (in
- * this case if the menu is visible). This thread manages the creation, destruction,
- * connection, and disconnection of the thread and its signals / slots.*/
+/* This method creates the worker the first time the menu is shown (or started ahead of time) and moves
+ * it to the worker thread, which is started once and kept running for the life of the menu. The worker
+ * warms up on its own thread as soon as the thread starts, so the GUI thread is never blocked by it.
+ * Hiding the menu leaves the worker idle in its event loop so that switching between menus does not
+ * pay for starting a thread or for building the OpenCL calls again.*/
 void AdjustMenu::manageWorker(bool life)
 {
-    if(life)
-    {
-        if(!adjustWorker_m)
-        {
-            //If worker is still trying to exit, wait and process other events until its done
-            if(worker_m.isRunning())
-            {
-                QApplication::setOverrideCursor(Qt::WaitCursor);
-                qDebug() << "Waiting for thread to exit";
-                while(!worker_m.isFinished())
-                {
-                    QApplication::processEvents(QEventLoop::AllEvents, 100);
-                }
-                QApplication::restoreOverrideCursor();
-            }
-
-            adjustWorker_m = new AdjustWorker(masterImage_m, previewImage_m, workerMutex_m);
-            adjustWorker_m->moveToThread(&worker_m);
-            //signal slot connections (might be able to do them in constructor?)
-            connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), adjustWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), adjustWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            connect(adjustWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            connect(adjustWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            worker_m.start();
-        }
-    }
-    else
+    if(life && !adjustWorker_m)
     {
-        //while the worker event loop is running, tell it to delete itself once loop is empty.
-        if(adjustWorker_m)
-        {
-            /* All signals to and from the object are automatically disconnected (string based, not functor),
-             * and any pending posted events for the object are removed from the event queue. This is done incase functor signal/slots used later*/
-            disconnect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), adjustWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            disconnect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), adjustWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            disconnect(adjustWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            disconnect(adjustWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            adjustWorker_m->deleteLater();
-            adjustWorker_m = nullptr;
-            worker_m.quit();
-        }
+        adjustWorker_m = new AdjustWorker(&sourceFrames_m, &previewFrames_m);
+        adjustWorker_m->moveToThread(&worker_m);
+        //the connections last as long as the worker, signals are only sent while the menu is visible
+        connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), adjustWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
+        connect(adjustWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
+        connect(adjustWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
+        connect(adjustWorker_m, SIGNAL(ready()), this, SLOT(setWorkerReady()));
+        connect(&worker_m, SIGNAL(started()), adjustWorker_m, SLOT(initialize()));
+        connect(&worker_m, SIGNAL(finished()), adjustWorker_m, SLOT(deleteLater()));
+        worker_m.start();
     }
 }
+
+/* Starts the worker ahead of the menu being shown so that its warm-up runs in the background while
+ * the user is busy with something else. Does nothing if the worker already exists.*/
+void AdjustMenu::startWorker()
+{
+    manageWorker(true);
+}
+
+// Records that the worker is ready and passes it on to the parent object
+void AdjustMenu::setWorkerReady()
+{
+    workerReady_m = true;
+    emit workerReady();
+}
@@ -47,6 +47,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           04/18/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Proxy Preview, Kept Worker
 *
 ************************************************************************/
 
@@ -57,10 +58,10 @@
 #include <QThread>
 #include "../../app_filters/signalsuppressor.h"
 #include <opencv2/core.hpp>
+#include "../../core/editprocessor.h"
+#include "../../core/triplebuffer.h"
 class QString;
-class QMutex;
 class AdjustWorker;
-class QByteArray;
 
 namespace Ui {
 class AdjustMenu;
@@ -71,48 +72,54 @@ class AdjustMenu : public QScrollArea
     Q_OBJECT
 
 public:
-    explicit AdjustMenu(QMutex *mutex = nullptr, QWidget *parent = 0);
+    explicit AdjustMenu(QWidget *parent = 0);
     ~AdjustMenu();
+    EditOperation editOperation() const;
+    EditOperation defaultOperation() const;
+    TripleBuffer *previewFrames();
+    bool isWorkerReady() const;
     enum ParameterIndex
     {
-        Brightness  = 0,
-        Contrast    = 1,
-        Depth       = 2,
-        Hue         = 3,
-        Saturation  = 4,
-        Intensity   = 5,
-        Gamma       = 6,
-        Highlight   = 7,
-        Shadows     = 8,
-        Color       = 9
+        Brightness  = AdjustProcessor::Brightness,
+        Contrast    = AdjustProcessor::Contrast,
+        Depth       = AdjustProcessor::Depth,
+        Hue         = AdjustProcessor::Hue,
+        Saturation  = AdjustProcessor::Saturation,
+        Intensity   = AdjustProcessor::Intensity,
+        Gamma       = AdjustProcessor::Gamma,
+        Highlight   = AdjustProcessor::Highlight,
+        Shadows     = AdjustProcessor::Shadows,
+        Color       = AdjustProcessor::Color
     };
 
 public slots:
     void initializeSliders();
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
+    void receiveSourceImage(const cv::Mat &image);
     void setMenuTracking(bool enable);
     void setVisible(bool visible) override;
     void showEvent(QShowEvent *event) override;
+    void startWorker();
 
 signals:
     void updateDisplayedImage();
-    void distributeImageBufferAddresses(const cv::Mat*,cv::Mat*);
     void updateStatus(QString);
+    void workerReady();
 
 protected:
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    QMutex *workerMutex_m;
+    TripleBuffer sourceFrames_m;
+    TripleBuffer previewFrames_m;
     QThread worker_m;
     AdjustWorker *adjustWorker_m;
+    bool workerReady_m;
 
 protected slots:
     void manageWorker(bool life);
+    void setWorkerReady();
 
 private:
     Ui::AdjustMenu *ui;
-    float sliderValues_m[10];
-    SignalSuppressor workSignalSuppressor;
+    AdjustProcessor::Parameters sliderValues_m;
+    ParameterSuppressor<AdjustProcessor::Parameters> workSignalSuppressor;
 
 private slots:
     void changeContrastValue(int value);
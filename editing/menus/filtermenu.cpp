@@ -48,6 +48,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           06/23/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Proxy Preview, Kept Worker
 *
 ************************************************************************/
 
@@ -60,19 +61,16 @@
 #include <QVector>
 #include <QPixmap>
 #include <QButtonGroup>
-#include <QByteArray>
 #include <QDebug>
 
 //Constructor initializes all members, installs event filters, and connects necessary signals / slots.
-FilterMenu::FilterMenu(QMutex *mutex, QWidget *parent) :
+FilterMenu::FilterMenu(QWidget *parent) :
     QScrollArea(parent),
     ui(new Ui::FilterMenu)
 {
     ui->setupUi(this);
-    masterImage_m = nullptr;
-    previewImage_m = nullptr;
-    workerMutex_m = mutex;
     filterWorker_m = nullptr;
+    workerReady_m = false;
 
     MouseWheelEaterEventFilter *wheelFilter = new MouseWheelEaterEventFilter(this);
     FocusInDetectorEventFilter *smoothFocusFilter = new FocusInDetectorEventFilter(this);
@@ -135,26 +133,62 @@ FilterMenu::FilterMenu(QMutex *mutex, QWidget *parent) :
 // destructor
 FilterMenu::~FilterMenu()
 {
-    //end worker thread once event loop finishes
-    if(filterWorker_m)
-    {
-        worker_m.terminate();
-        worker_m.wait();
-        delete filterWorker_m;
-        filterWorker_m = nullptr;
-    }
+    //end worker thread once event loop finishes, the worker is deleted as the thread finishes
+    worker_m.quit();
+    worker_m.wait();
+    filterWorker_m = nullptr;
     delete ui;
 }
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the parent object. If the Mat's become empty in the parent object this slot
- * should be signaled with nullptrs to signify they are empty. */
-void FilterMenu::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
+/* This slot publishes the image the worker renders the previews from. The image is shared with the
+ * parent object, which must not write to it afterwards, and is empty if no image is open. The worker
+ * acquires it the next time it renders, so no lock is held by either thread. The region of the frame's
+ * operation holds the full resolution size the image was reduced from, so the worker can scale the
+ * kernels given in pixels to it.*/
+void FilterMenu::receiveSourceImage(const cv::Mat &image)
+{
+    EditOperation frame{};
+    frame.region = cv::Rect(cv::Point(0, 0), fullResolutionSize_m);
+    sourceFrames_m.writeBuffer() = image;
+    sourceFrames_m.publish(frame);
+    sourceFrames_m.writeBuffer().release();
+}
+
+/* This slot sets the size of the full resolution image the next source image was reduced from (the
+ * master, or its tiles if it is tiled). It must be received before the source image.*/
+void FilterMenu::receiveFullResolutionSize(const cv::Size &size)
+{
+    fullResolutionSize_m = size;
+}
+
+/* Returns the frames the worker publishes its previews to. Only the GUI thread may acquire them and
+ * the latest frame remains in the read buffer until the next one is acquired.*/
+TripleBuffer *FilterMenu::previewFrames()
+{
+    return &previewFrames_m;
+}
+
+/* Returns true once the worker has finished its start up, including the OpenCL warm-up of its
+ * processor, and renders previews without an initial delay.*/
+bool FilterMenu::isWorkerReady() const
 {
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Filter Menu Images:" << masterImage_m << previewImage_m;
-    emit distributeImageBufferAddresses(masterImage, previewImage);
+    return workerReady_m;
+}
+
+/* Returns the filter last sent to the worker so that it can be rendered again at a different
+ * resolution (e.g. at full resolution when a proxy preview is applied). If no filter is selected
+ * the operation type is None.*/
+EditOperation FilterMenu::editOperation() const
+{
+    EditOperation operation{};
+    if(!ui->radioButton_SmoothEnable->isChecked() && !ui->radioButton_SharpenEnable->isChecked()
+            && !ui->radioButton_EdgeEnable->isChecked())
+        return operation; //no filter selected
+
+    operation.type = EditOperation::Filter;
+    for(int i = 0; i < FilterProcessor::ParameterCount; i++)
+        operation.filterParameters[i] = menuValues_m[i];
+    return operation;
 }
 
 // Enables or disables tracking for the appropriate menu widgets
@@ -245,7 +279,7 @@ void FilterMenu::collectBlurParameters()
     menuValues_m[KernelWeight] = ui->horizontalSlider_SmoothWeight->value();
     menuValues_m[KernelOperation] = SmoothFilter;
 
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&menuValues_m), sizeof(int) * 3));
+    workSignalSuppressor.receiveNewData(menuValues_m);
 }
 
 //Populates the menuValues_m parameter and passes it to a worker slot for the Sharpen operation.
@@ -258,7 +292,7 @@ void FilterMenu::collectSharpenParameters()
     menuValues_m[KernelWeight] = ui->horizontalSlider_SharpenWeight->value();
     menuValues_m[KernelOperation] = SharpenFilter;
 
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&menuValues_m), sizeof(int) * 3));
+    workSignalSuppressor.receiveNewData(menuValues_m);
 }
 
 //Populates the menuValues_m parameter and passes it to a worker slot for the Edge Detect operation.
@@ -272,7 +306,7 @@ void FilterMenu::collectEdgeDetectParameters()
     menuValues_m[KernelWeight] = ui->horizontalSlider_EdgeWeight->value() * 2 + 1;
     menuValues_m[KernelOperation] = EdgeFilter;
 
-    workSignalSuppressor.receiveNewData(QByteArray(reinterpret_cast<char*>(&menuValues_m), sizeof(int) * 3));
+    workSignalSuppressor.receiveNewData(menuValues_m);
 }
 
 //Sets the sample image based on the menu item selected.
@@ -303,52 +337,38 @@ void FilterMenu::showEvent(QShowEvent *event)
     QWidget::showEvent(event);
 }
 
-/* This method determines when the worker thread should be created or destroyed so
- * that the worker thread (with event loop) is only running if it is required (in
- * this case if the menu is visible). This thread manages the creation, destruction,
- * connection, and disconnection of the thread and its signals / slots.*/
+/* This method creates the worker the first time the menu is shown (or started ahead of time) and moves
+ * it to the worker thread, which is started once and kept running for the life of the menu. The worker
+ * warms up on its own thread as soon as the thread starts, so the GUI thread is never blocked by it.
+ * Hiding the menu leaves the worker idle in its event loop so that switching between menus does not
+ * pay for starting a thread or for building the OpenCL calls again.*/
 void FilterMenu::manageWorker(bool life)
 {
-    if(life)
-    {
-        if(!filterWorker_m)
-        {
-            //If worker is still trying to exit, wait and process other events until its done
-            if(worker_m.isRunning())
-            {
-                QApplication::setOverrideCursor(Qt::WaitCursor);
-                qDebug() << "Waiting for thread to exit";
-                while(!worker_m.isFinished())
-                {
-                    QApplication::processEvents(QEventLoop::AllEvents, 100);
-                }
-                QApplication::restoreOverrideCursor();
-            }
-
-            filterWorker_m = new FilterWorker(masterImage_m, previewImage_m, workerMutex_m);
-            filterWorker_m->moveToThread(&worker_m);
-            //signal slot connections (might be able to do them in constructor?)
-            connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), filterWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), filterWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            connect(filterWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            connect(filterWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            worker_m.start();
-        }
-    }
-    else
+    if(life && !filterWorker_m)
     {
-        //while the worker event loop is running, tell it to delete itself once loop is empty.
-        if(filterWorker_m)
-        {
-            /* All signals to and from the object are automatically disconnected (string based, not functor),
-             * and any pending posted events for the object are removed from the event queue. This is done incase functor signal/slots used later*/
-            disconnect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), filterWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            disconnect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), filterWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            disconnect(filterWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            disconnect(filterWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            filterWorker_m->deleteLater();
-            filterWorker_m = nullptr;
-            worker_m.quit();
-        }
+        filterWorker_m = new FilterWorker(&sourceFrames_m, &previewFrames_m);
+        filterWorker_m->moveToThread(&worker_m);
+        //the connections last as long as the worker, signals are only sent while the menu is visible
+        connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), filterWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
+        connect(filterWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
+        connect(filterWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
+        connect(filterWorker_m, SIGNAL(ready()), this, SLOT(setWorkerReady()));
+        connect(&worker_m, SIGNAL(started()), filterWorker_m, SLOT(initialize()));
+        connect(&worker_m, SIGNAL(finished()), filterWorker_m, SLOT(deleteLater()));
+        worker_m.start();
     }
 }
+
+/* Starts the worker ahead of the menu being shown so that its warm-up runs in the background while
+ * the user is busy with something else. Does nothing if the worker already exists.*/
+void FilterMenu::startWorker()
+{
+    manageWorker(true);
+}
+
+// Records that the worker is ready and passes it on to the parent object
+void FilterMenu::setWorkerReady()
+{
+    workerReady_m = true;
+    emit workerReady();
+}
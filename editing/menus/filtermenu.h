@@ -48,6 +48,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           06/23/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Proxy Preview, Kept Worker
 *
 ************************************************************************/
 
@@ -58,10 +59,10 @@
 #include <QThread>
 #include "../../app_filters/signalsuppressor.h"
 #include <opencv2/core.hpp>
+#include "../../core/editprocessor.h"
+#include "../../core/triplebuffer.h"
 class QButtonGroup;
-class QByteArray;
 class QString;
-class QMutex;
 class FilterWorker;
 
 namespace Ui {
@@ -73,58 +74,63 @@ class FilterMenu : public QScrollArea
     Q_OBJECT
 
 public:
-    explicit FilterMenu(QMutex *mutex, QWidget *parent = 0);
+    explicit FilterMenu(QWidget *parent = 0);
     ~FilterMenu();
+    EditOperation editOperation() const;
+    TripleBuffer *previewFrames();
+    bool isWorkerReady() const;
     enum ParameterIndex
     {
-        FilterAverage       = 0,
-        FilterGaussian      = 1,
-        FilterMedian        = 2,
+        FilterAverage       = FilterProcessor::FilterAverage,
+        FilterGaussian      = FilterProcessor::FilterGaussian,
+        FilterMedian        = FilterProcessor::FilterMedian,
 
-        FilterUnsharpen     = 0,
-        FilterLaplacian     = 1,
+        FilterUnsharpen     = FilterProcessor::FilterUnsharpen,
+        FilterLaplacian     = FilterProcessor::FilterLaplacian,
 
-        FilterCanny         = 0,
-        FilterSobel         = 2,
-
-        SmoothFilter        = 0,
-        SharpenFilter       = 1,
-        EdgeFilter          = 2,
-
-        KernelType          = 0,
-        KernelWeight        = 1,
-        KernelOperation     = 2
+        FilterCanny         = FilterProcessor::FilterCanny,
+        FilterSobel         = FilterProcessor::FilterSobel,
 
+        SmoothFilter        = FilterProcessor::SmoothFilter,
+        SharpenFilter       = FilterProcessor::SharpenFilter,
+        EdgeFilter          = FilterProcessor::EdgeFilter,
 
+        KernelType          = FilterProcessor::KernelType,
+        KernelWeight        = FilterProcessor::KernelWeight,
+        KernelOperation     = FilterProcessor::KernelOperation
     };
 
 public slots:
     void initializeSliders();
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
+    void receiveSourceImage(const cv::Mat &image);
+    void receiveFullResolutionSize(const cv::Size &size);
     void setMenuTracking(bool enable);
     void setVisible(bool visible) override;
     void showEvent(QShowEvent *event) override;
+    void startWorker();
 
 signals:
     void updateDisplayedImage();
-    void distributeImageBufferAddresses(const cv::Mat*, cv::Mat*);
     void updateStatus(QString);
+    void workerReady();
 
 protected:
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    QMutex *workerMutex_m;
+    TripleBuffer sourceFrames_m;
+    TripleBuffer previewFrames_m;
     QThread worker_m;
     FilterWorker *filterWorker_m;
+    bool workerReady_m;
+    cv::Size fullResolutionSize_m;
 
 protected slots:
     void manageWorker(bool life);
+    void setWorkerReady();
 
 private:
     Ui::FilterMenu *ui;
-    int menuValues_m[3];
+    FilterProcessor::Parameters menuValues_m;
     QButtonGroup *buttonGroup_m;
-    SignalSuppressor workSignalSuppressor;
+    ParameterSuppressor<FilterProcessor::Parameters> workSignalSuppressor;
 
 private slots:
     void adjustSharpenSliderRange(int value);
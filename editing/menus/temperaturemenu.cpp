@@ -40,6 +40,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           07/02/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Proxy Preview, Kept Worker
 *
 ************************************************************************/
 #include "temperaturemenu.h"
@@ -53,15 +54,13 @@
 
 /* Constructor installs the MouseWheelEaterFilter for the slider, groups the buttons together for
  * to easily search for the selected button, and establishes all signals/slots necessary.*/
-TemperatureMenu::TemperatureMenu(QMutex *mutex, QWidget *parent) :
+TemperatureMenu::TemperatureMenu(QWidget *parent) :
     QScrollArea(parent),
     ui(new Ui::TemperatureMenu)
 {
     ui->setupUi(this);
-    masterImage_m = nullptr;
-    previewImage_m = nullptr;
-    workerMutex_m = mutex;
     temperatureWorker_m = nullptr;
+    workerReady_m = false;
 
     MouseWheelEaterEventFilter *wheelFilter = new MouseWheelEaterEventFilter(this);
     ui->horizontalSlider_Temperature->installEventFilter(wheelFilter);
@@ -98,26 +97,55 @@ TemperatureMenu::TemperatureMenu(QMutex *mutex, QWidget *parent) :
 //autogenerated destructor
 TemperatureMenu::~TemperatureMenu()
 {
-    //end worker thread once event loop finishes
-    if(temperatureWorker_m)
-    {
-        worker_m.terminate();
-        worker_m.wait();
-        delete temperatureWorker_m; //safe? Different way to handle this?
-        temperatureWorker_m = nullptr;
-    }
+    //end worker thread once event loop finishes, the worker is deleted as the thread finishes
+    worker_m.quit();
+    worker_m.wait();
+    temperatureWorker_m = nullptr;
     delete ui;
 }
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the parent object. If the Mat's become empty in the parent object this slot
- * should be signaled with nullptrs to signify they are empty. */
-void TemperatureMenu::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
+/* This slot publishes the image the worker renders the previews from. The image is shared with the
+ * parent object, which must not write to it afterwards, and is empty if no image is open. The worker
+ * acquires it the next time it renders, so no lock is held by either thread.*/
+void TemperatureMenu::receiveSourceImage(const cv::Mat &image)
+{
+    sourceFrames_m.writeBuffer() = image;
+    sourceFrames_m.publish();
+    sourceFrames_m.writeBuffer().release();
+}
+
+/* Returns the frames the worker publishes its previews to. Only the GUI thread may acquire them and
+ * the latest frame remains in the read buffer until the next one is acquired.*/
+TripleBuffer *TemperatureMenu::previewFrames()
+{
+    return &previewFrames_m;
+}
+
+/* Returns true once the worker has finished its start up, including the OpenCL warm-up of its
+ * processor, and renders previews without an initial delay.*/
+bool TemperatureMenu::isWorkerReady() const
+{
+    return workerReady_m;
+}
+
+/* Returns the temperature shift currently selected by the slider so that it can be rendered again
+ * at a different resolution (e.g. at full resolution when a proxy preview is applied).*/
+EditOperation TemperatureMenu::editOperation() const
+{
+    EditOperation operation{};
+    operation.type = EditOperation::Temperature;
+    operation.value = ui->horizontalSlider_Temperature->value();
+    return operation;
+}
+
+/* Returns the operation of the menu when its slider is initialized to the middle of its range. This is not
+ * an identity, so it is only applied once a preview has been rendered for it.*/
+EditOperation TemperatureMenu::defaultOperation() const
 {
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Adjust Menu Images:" << masterImage_m << previewImage_m;
-    emit distributeImageBufferAddresses(masterImage, previewImage);
+    EditOperation operation{};
+    operation.type = EditOperation::Temperature;
+    operation.value = (ui->horizontalSlider_Temperature->minimum() + ui->horizontalSlider_Temperature->maximum()) / 2;
+    return operation;
 }
 
 // Enables or disables tracking for the appropriate menu widgets
@@ -130,8 +158,7 @@ void TemperatureMenu::setMenuTracking(bool enable)
 void TemperatureMenu::initializeSliders()
 {
     ui->horizontalSlider_Temperature->blockSignals(true);
-    int middle = (ui->horizontalSlider_Temperature->minimum() + ui->horizontalSlider_Temperature->maximum()) / 2;
-    ui->horizontalSlider_Temperature->setValue(middle);
+    ui->horizontalSlider_Temperature->setValue(defaultOperation().value);
     deselectRadioButtonFromSlider();
     ui->horizontalSlider_Temperature->blockSignals(false);
 }
@@ -186,53 +213,38 @@ void TemperatureMenu::sendTemperatureValue(int value)
     workSignalSuppressor.receiveNewData(value);
 }
 
-/* This method determines when the worker thread should be created or destroyed so
- * that the worker thread (with event loop) is only running if it is required (in
- * this case if the menu is visible). This thread manages the creation, destruction,
- * connection, and disconnection of the thread and its signals / slots.*/
+/* This method creates the worker the first time the menu is shown (or started ahead of time) and moves
+ * it to the worker thread, which is started once and kept running for the life of the menu. The worker
+ * warms up on its own thread as soon as the thread starts, so the GUI thread is never blocked by it.
+ * Hiding the menu leaves the worker idle in its event loop so that switching between menus does not
+ * pay for starting a thread or for building the OpenCL calls again.*/
 void TemperatureMenu::manageWorker(bool life)
 {
-    if(life)
-    {
-        if(!temperatureWorker_m)
-        {
-            //If worker is still trying to exit, wait and process other events until its done
-            if(worker_m.isRunning())
-            {
-                QApplication::setOverrideCursor(Qt::WaitCursor);
-                qDebug() << "Waiting for thread to exit";
-                while(!worker_m.isFinished())
-                {
-                    QApplication::processEvents(QEventLoop::AllEvents, 100);
-                }
-                QApplication::restoreOverrideCursor();
-            }
-
-            temperatureWorker_m = new TemperatureWorker(masterImage_m, previewImage_m, workerMutex_m);
-            temperatureWorker_m->moveToThread(&worker_m);
-            //signal slot connections (might be able to do them in constructor?)
-            connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), temperatureWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), temperatureWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            connect(temperatureWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            connect(temperatureWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            worker_m.start();
-        }
-    }
-    else
+    if(life && !temperatureWorker_m)
     {
-        //while the worker event loop is running, tell it to delete itself once loop is empty.
-        if(temperatureWorker_m)
-        {
-            /* All signals to and from the object are automatically disconnected (string based, not functor),
-             * and any pending posted events for the object are removed from the event queue. This is done incase functor signal/slots used later*/
-            disconnect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), temperatureWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            disconnect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), temperatureWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
-            disconnect(temperatureWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            disconnect(temperatureWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            temperatureWorker_m->deleteLater();
-            temperatureWorker_m = nullptr;
-            worker_m.quit();
-        }
+        temperatureWorker_m = new TemperatureWorker(&sourceFrames_m, &previewFrames_m);
+        temperatureWorker_m->moveToThread(&worker_m);
+        //the connections last as long as the worker, signals are only sent while the menu is visible
+        connect(&workSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), temperatureWorker_m, SLOT(receiveSuppressedSignal(SignalSuppressor*)));
+        connect(temperatureWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
+        connect(temperatureWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
+        connect(temperatureWorker_m, SIGNAL(ready()), this, SLOT(setWorkerReady()));
+        connect(&worker_m, SIGNAL(started()), temperatureWorker_m, SLOT(initialize()));
+        connect(&worker_m, SIGNAL(finished()), temperatureWorker_m, SLOT(deleteLater()));
+        worker_m.start();
     }
+}
 
+/* Starts the worker ahead of the menu being shown so that its warm-up runs in the background while
+ * the user is busy with something else. Does nothing if the worker already exists.*/
+void TemperatureMenu::startWorker()
+{
+    manageWorker(true);
+}
+
+// Records that the worker is ready and passes it on to the parent object
+void TemperatureMenu::setWorkerReady()
+{
+    workerReady_m = true;
+    emit workerReady();
 }
@@ -40,6 +40,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           07/02/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Proxy Preview, Kept Worker
 *
 ************************************************************************/
 #ifndef TEMPERATUREMENU_H
@@ -49,10 +50,10 @@
 #include <QThread>
 #include <opencv2/core.hpp>
 #include "../../app_filters/signalsuppressor.h"
+#include "../../core/editprocessor.h"
+#include "../../core/triplebuffer.h"
 class QString;
-class QMutex;
 class TemperatureWorker;
-class QByteArray;
 class QButtonGroup;
 
 namespace Ui {
@@ -64,35 +65,41 @@ class TemperatureMenu : public QScrollArea
     Q_OBJECT
 
 public:
-    explicit TemperatureMenu(QMutex *mutex, QWidget *parent = 0);
+    explicit TemperatureMenu(QWidget *parent = 0);
     ~TemperatureMenu();
+    EditOperation editOperation() const;
+    EditOperation defaultOperation() const;
+    TripleBuffer *previewFrames();
+    bool isWorkerReady() const;
 
 public slots:
     void initializeSliders();
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
+    void receiveSourceImage(const cv::Mat &image);
     void setMenuTracking(bool enable);
     void setVisible(bool visible) override;
     void showEvent(QShowEvent *event) override;
+    void startWorker();
 
 signals:
     void updateDisplayedImage();
-    void distributeImageBufferAddresses(const cv::Mat*,cv::Mat*);
     void updateStatus(QString);
+    void workerReady();
 
 protected:
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    QMutex *workerMutex_m;
+    TripleBuffer sourceFrames_m;
+    TripleBuffer previewFrames_m;
     QThread worker_m;
     TemperatureWorker *temperatureWorker_m;
+    bool workerReady_m;
 
 protected slots:
     void manageWorker(bool life);
+    void setWorkerReady();
 
 private:
     Ui::TemperatureMenu *ui;
     QButtonGroup *buttonGroup_m;
-    SignalSuppressor workSignalSuppressor;
+    ParameterSuppressor<int> workSignalSuppressor;
 
 private slots:
     void moveSliderToButton(bool adjustSlider);
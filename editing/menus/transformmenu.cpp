@@ -40,6 +40,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           01/25/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Rotation Preview, Kept Worker
 *
 ************************************************************************/
 #include "../../app_filters/mousewheeleatereventfilter.h"
@@ -62,15 +63,13 @@
 
 /* Constructor installs the necessary filters for different objects, groups the buttons together
  * to easily search for the selected button, and establishes all signals/slots necessary.*/
-TransformMenu::TransformMenu(QMutex *mutex, QWidget *parent) :
+TransformMenu::TransformMenu(QWidget *parent) :
     QScrollArea(parent),
     ui(new Ui::TransformMenu)
 {
     ui->setupUi(this);
-    masterImage_m = nullptr;
-    previewImage_m = nullptr;
-    workerMutex_m = mutex;
     transformWorker_m = nullptr;
+    workerReady_m = false;
 
     MouseWheelEaterEventFilter *wheelFilter = new MouseWheelEaterEventFilter(this);
     FocusInDetectorEventFilter *cropFocusFilter = new FocusInDetectorEventFilter(this);
@@ -103,6 +102,9 @@ TransformMenu::TransformMenu(QMutex *mutex, QWidget *parent) :
     connect(ui->spinBox_RotateDegrees, SIGNAL(valueChanged(int)), ui->horizontalSlider_Rotate, SLOT(setValue(int)));
     connect(ui->horizontalSlider_Rotate, SIGNAL(valueChanged(int)), ui->spinBox_RotateDegrees, SLOT(setValue(int)));
     connect(ui->spinBox_RotateDegrees, SIGNAL(valueChanged(int)), this, SLOT(resendImageRotateSignal()));
+    connect(ui->horizontalSlider_Rotate, SIGNAL(sliderPressed()), this, SLOT(startRotatePreview()));
+    connect(ui->horizontalSlider_Rotate, SIGNAL(sliderMoved(int)), this, SLOT(sendRotatePreview(int)));
+    connect(ui->horizontalSlider_Rotate, SIGNAL(sliderReleased()), this, SLOT(finishRotatePreview()));
     connect(ui->checkBox_rotateAutoCrop, SIGNAL(toggled(bool)), this, SIGNAL(setAutoCropOnRotate(bool)));
     connect(ui->checkBox_rotateAutoCrop, SIGNAL(toggled(bool)), this, SLOT(resendImageRotateSignal()));
     connect(ui->radioButton_RotateEnable, SIGNAL(toggled(bool)), this, SLOT(changeSampleImage(bool)));
@@ -132,25 +134,35 @@ TransformMenu::TransformMenu(QMutex *mutex, QWidget *parent) :
 //autogenerated destructor
 TransformMenu::~TransformMenu()
 {
-    if(transformWorker_m)
-    {
-        worker_m.terminate();
-        worker_m.wait();
-        delete transformWorker_m;
-        transformWorker_m = nullptr;
-    }
+    //end worker thread once event loop finishes, the worker is deleted as the thread finishes
+    worker_m.quit();
+    worker_m.wait();
+    transformWorker_m = nullptr;
     delete ui;
 }
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the parent object. If the Mat's become empty in the parent object this slot
- * should be signaled with nullptrs to signify they are empty. */
-void TransformMenu::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
+/* This slot publishes the image the worker renders the previews from. The image is shared with the
+ * parent object, which must not write to it afterwards, and is empty if no image is open. The worker
+ * acquires it the next time it renders, so no lock is held by either thread.*/
+void TransformMenu::receiveSourceImage(const cv::Mat &image)
+{
+    sourceFrames_m.writeBuffer() = image;
+    sourceFrames_m.publish();
+    sourceFrames_m.writeBuffer().release();
+}
+
+/* Returns the frames the worker publishes its previews to. Only the GUI thread may acquire them and
+ * the latest frame remains in the read buffer until the next one is acquired.*/
+TripleBuffer *TransformMenu::previewFrames()
 {
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Filter Menu Images:" << masterImage_m << previewImage_m;
-    emit distributeImageBufferAddresses(masterImage, previewImage);
+    return &previewFrames_m;
+}
+
+/* Returns true once the worker has finished its start up, including the OpenCL warm-up of its
+ * processor, and renders previews without an initial delay.*/
+bool TransformMenu::isWorkerReady() const
+{
+    return workerReady_m;
 }
 
 // Enables or disables tracking for the appropriate menu widgets
@@ -234,6 +246,7 @@ void TransformMenu::initializeSliders()
 
     ui->label_SampleImage->setPixmap(QPixmap::fromImage(QImage(":/img/icons/masterIcons/rgb.png")));
     emit setGetCoordinateMode(ImageLabel::CoordinateMode::NoClick);
+    emit previewRotation(0, false);
 }
 
 // setImageResolution sets the default image resolution for initializing menu items
@@ -353,9 +366,37 @@ void TransformMenu::setSelectInImage(bool checked)
 //sends a signal to perform the image rotate operation. Intended to send value again to kick off operation @ toggle event
 void TransformMenu::resendImageRotateSignal()
 {
+    //while dragging the rotation is only drawn by the image label, it is computed when the slider is released
+    if(ui->horizontalSlider_Rotate->isSliderDown())
+        return;
+
     workRotateSignalSuppressor.receiveNewData(ui->spinBox_RotateDegrees->value());
 }
 
+/* When the rotate slider is grabbed the unrotated master is displayed so that the image label can draw it
+ * rotated, rather than rotating the previous rotation again.*/
+void TransformMenu::startRotatePreview()
+{
+    emit displayMaster();
+    sendRotatePreview(ui->horizontalSlider_Rotate->sliderPosition());
+}
+
+// Asks the image label to draw the displayed image rotated by degree while the rotate slider is dragged
+void TransformMenu::sendRotatePreview(int degree)
+{
+    emit previewRotation(degree, ui->checkBox_rotateAutoCrop->isChecked());
+}
+
+/* When the rotate slider is released the rotation is computed by the worker. Without tracking the slider
+ * emits valueChanged after it is released if it moved, which does this through resendImageRotateSignal. The
+ * preview is cleared when the rotated image is displayed.*/
+void TransformMenu::finishRotatePreview()
+{
+    if(ui->horizontalSlider_Rotate->hasTracking()
+            || ui->horizontalSlider_Rotate->sliderPosition() == ui->horizontalSlider_Rotate->value())
+        resendImageRotateSignal();
+}
+
 /* setImageInternalSizeHeight sets the member storing the desired Scaled Image Size according to the new value in
  * spinBox_ScaleHeight. If the ScaleLinked checkbox is checked, the width is dynamically adjusted to maintain the
  * aspect ratio of the image. The labels indicating the % the image is scaled are also updated. */
@@ -409,6 +450,32 @@ QRect TransformMenu::getSizeOfScale() const
     return croppedROI_m;
 }
 
+/* Returns the transform selected in the menu so that it can be applied again to a different resolution
+ * of the image (e.g. to the tiles of a very large image). The crop region and scale size are in pixels of
+ * the image the menu was given. If no transform is selected the operation type is None.*/
+EditOperation TransformMenu::editOperation() const
+{
+    EditOperation operation{};
+    if(ui->radioButton_CropEnable->isChecked())
+    {
+        operation.type = EditOperation::Crop;
+        operation.region = cv::Rect(croppedROI_m.topLeft().x(), croppedROI_m.topLeft().y(),
+                                    croppedROI_m.width(), croppedROI_m.height());
+    }
+    else if(ui->radioButton_RotateEnable->isChecked())
+    {
+        operation.type = EditOperation::Rotate;
+        operation.value = ui->spinBox_RotateDegrees->value();
+        operation.autoCrop = ui->checkBox_rotateAutoCrop->isChecked();
+    }
+    else if(ui->radioButton_ScaleEnable->isChecked())
+    {
+        operation.type = EditOperation::Scale;
+        operation.region = cv::Rect(0, 0, ui->spinBox_ScaleWidth->value(), ui->spinBox_ScaleHeight->value());
+    }
+    return operation;
+}
+
 /* Preloads the Scale signal suppressor. This should only be called from this object when previewing the image. A different
  * trigger will signal the worker thread to perform the final image transformation so it is not doing extra work each
  * time a value is adjusted*/
@@ -441,63 +508,44 @@ void TransformMenu::exceptionDialog(QString message)
     QMessageBox::warning(this, "Error", message);
 }
 
-/* This method determines when the worker thread should be created or destroyed so
- * that the worker thread (with event loop) is only running if it is required (in
- * this case if the menu is visible). This thread manages the creation, destruction,
- * connection, and disconnection of the thread and its signals / slots.*/
+/* This method creates the worker the first time the menu is shown (or started ahead of time) and moves
+ * it to the worker thread, which is started once and kept running for the life of the menu. The worker
+ * warms up on its own thread as soon as the thread starts, so the GUI thread is never blocked by it.
+ * Hiding the menu leaves the worker idle in its event loop so that switching between menus does not
+ * pay for starting a thread or for building the OpenCL calls again.*/
 void TransformMenu::manageWorker(bool life)
 {
-    if(life)
+    if(life && !transformWorker_m)
     {
-        if(!transformWorker_m)
-        {
-            //If worker is still trying to exit, wait and process other events until its done
-            if(worker_m.isRunning())
-            {
-                QApplication::setOverrideCursor(Qt::WaitCursor);
-                qDebug() << "Waiting for thread to exit";
-                while(!worker_m.isFinished())
-                {
-                    QApplication::processEvents(QEventLoop::AllEvents, 100);
-                }
-                QApplication::restoreOverrideCursor();
-            }
-
-            transformWorker_m = new TransformWorker(masterImage_m, previewImage_m, workerMutex_m);
-            transformWorker_m->moveToThread(&worker_m);
-            //signal slot connections (might be able to do them in constructor?)
-            connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), transformWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            connect(&workRotateSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveRotateSuppressedSignal(SignalSuppressor*)));
-            connect(&workScaleSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveScaleSuppressedSignal(SignalSuppressor*)));
-            //other worker signals slots
-            connect(transformWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            connect(transformWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            connect(this, SIGNAL(performImageCrop(QRect)), transformWorker_m, SLOT(doCropComputation(QRect)));
-            connect(this, SIGNAL(setAutoCropOnRotate(bool)), transformWorker_m, SLOT(setAutoCropForRotate(bool)));
-            connect(transformWorker_m, SIGNAL(handleExceptionMessage(QString)), this, SLOT(exceptionDialog(QString)));
-            worker_m.start();
-        }
-    }
-    else
-    {
-        //while the worker event loop is running, tell it to delete itself once loop is empty.
-        if(transformWorker_m)
-        {
-            /* All signals to and from the object are automatically disconnected (string based, not functor),
-             * and any pending posted events for the object are removed from the event queue. This is done incase functor signal/slots used later*/
-            disconnect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*,cv::Mat*)), transformWorker_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
-            disconnect(&workRotateSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveRotateSuppressedSignal(SignalSuppressor*)));
-            disconnect(&workScaleSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveScaleSuppressedSignal(SignalSuppressor*)));
-            //other worker signals slots
-            disconnect(transformWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
-            disconnect(transformWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
-            disconnect(this, SIGNAL(performImageCrop(QRect)), transformWorker_m, SLOT(doCropComputation(QRect)));
-            disconnect(this, SIGNAL(setAutoCropOnRotate(bool)), transformWorker_m, SLOT(setAutoCropForRotate(bool)));
-            disconnect(transformWorker_m, SIGNAL(handleExceptionMessage(QString)), this, SLOT(exceptionDialog(QString)));
-            transformWorker_m->deleteLater();
-            transformWorker_m = nullptr;
-            worker_m.quit();
-        }
+        transformWorker_m = new TransformWorker(&sourceFrames_m, &previewFrames_m);
+        transformWorker_m->moveToThread(&worker_m);
+        //the connections last as long as the worker, signals are only sent while the menu is visible
+        connect(&workRotateSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveRotateSuppressedSignal(SignalSuppressor*)));
+        connect(&workScaleSignalSuppressor, SIGNAL(suppressedSignal(SignalSuppressor*)), transformWorker_m, SLOT(receiveScaleSuppressedSignal(SignalSuppressor*)));
+        //other worker signals slots
+        connect(transformWorker_m, SIGNAL(updateDisplayedImage()), this, SIGNAL(updateDisplayedImage()));
+        connect(transformWorker_m, SIGNAL(updateStatus(QString)), this, SIGNAL(updateStatus(QString)));
+        connect(this, SIGNAL(performImageCrop(QRect)), transformWorker_m, SLOT(doCropComputation(QRect)));
+        connect(this, SIGNAL(setAutoCropOnRotate(bool)), transformWorker_m, SLOT(setAutoCropForRotate(bool)));
+        connect(transformWorker_m, SIGNAL(handleExceptionMessage(QString)), this, SLOT(exceptionDialog(QString)));
+        connect(transformWorker_m, SIGNAL(ready()), this, SLOT(setWorkerReady()));
+        connect(&worker_m, SIGNAL(started()), transformWorker_m, SLOT(initialize()));
+        connect(&worker_m, SIGNAL(finished()), transformWorker_m, SLOT(deleteLater()));
+        worker_m.start();
     }
 }
 
+/* Starts the worker ahead of the menu being shown so that its warm-up runs in the background while
+ * the user is busy with something else. Does nothing if the worker already exists.*/
+void TransformMenu::startWorker()
+{
+    manageWorker(true);
+}
+
+// Records that the worker is ready and passes it on to the parent object
+void TransformMenu::setWorkerReady()
+{
+    workerReady_m = true;
+    emit workerReady();
+}
+
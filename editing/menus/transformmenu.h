@@ -40,6 +40,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           01/25/2018      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Rotation Preview, Kept Worker
 *
 ************************************************************************/
 #ifndef TRANSFORMMENU_H
@@ -48,7 +49,10 @@
 #include <QScrollArea>
 #include <QThread>
 #include <QVector>
+#include <QRect>
 #include "../../app_filters/signalsuppressor.h"
+#include "../../core/editprocessor.h"
+#include "../../core/triplebuffer.h"
 #include <opencv2/core.hpp>
 class QString;
 class QButtonGroup;
@@ -64,7 +68,7 @@ class TransformMenu : public QScrollArea
     Q_OBJECT
 
 public:
-    explicit TransformMenu(QMutex *mutex, QWidget *parent = 0);
+    explicit TransformMenu(QWidget *parent = 0);
     ~TransformMenu();
     enum ParameterIndex
     {
@@ -72,20 +76,24 @@ public:
         Perspective = 1
     };
     QRect getSizeOfScale() const;
+    EditOperation editOperation() const;
+    TripleBuffer *previewFrames();
+    bool isWorkerReady() const;
 
 public slots:
     void initializeSliders();
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
+    void receiveSourceImage(const cv::Mat &image);
     void setMenuTracking(bool enable);
     void setImageResolution(const QRect &imageSize);
     void setImageROI(QRect ROI);
     void setVisible(bool visible) override;
     void showEvent(QShowEvent *event) override;
+    void startWorker();
 
 signals:
     void updateDisplayedImage();
-    void distributeImageBufferAddresses(const cv::Mat*, cv::Mat*);
     void updateStatus(QString);
+    void workerReady();
     void enableCropImage(bool); //mainwindow sends ROI to here, when performImageCrop is emitted, then sends the ROI value to worker when apply is selected.
     void performImageCrop(QRect ROI); //if same size as image nothing happens. -> after apply is hit this is released
     void giveImageROI(QRect ROI);
@@ -94,16 +102,18 @@ signals:
     void setAutoCropOnRotate(bool);
     void performImageScale(QRect size);
     void displayMaster();
+    void previewRotation(int degree, bool autoCrop);
 
 protected:
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    QMutex *workerMutex_m;
+    TripleBuffer sourceFrames_m;
+    TripleBuffer previewFrames_m;
     QThread worker_m;
     TransformWorker *transformWorker_m;
+    bool workerReady_m;
 
 protected slots:
     void manageWorker(bool life);
+    void setWorkerReady();
     void exceptionDialog(QString);
 
 private:
@@ -113,13 +123,16 @@ private:
     QRect imageSize_m;
     QRect croppedROI_m;
     QVector<int> menuValues_m;
-    SignalSuppressor workRotateSignalSuppressor;
-    SignalSuppressor workScaleSignalSuppressor;
+    ParameterSuppressor<int> workRotateSignalSuppressor;
+    ParameterSuppressor<QRect> workScaleSignalSuppressor;
 
 private slots:
     void setSelectInImage(bool checked);
     void setImageInternalROI();
     void resendImageRotateSignal();
+    void startRotatePreview();
+    void sendRotatePreview(int degree);
+    void finishRotatePreview();
     void setImageInternalSizeWidth(int width);
     void setImageInternalSizeHeight(int height);
     void setImageInterSizeOnFocusIn(bool focus);
@@ -31,17 +31,17 @@
 *       This is the worker thread object tied to the adjustmenu.cpp object.
 *       The worker performs the operations for adjusting the color, brightness,
 *       contrast, pixel depth, hue, saturation, intensity including high and low
-*       adjustments to gamma correction. It collects all necessary slider
-*       values in a QVarient and copies the object through the signal/signal
-*       mechanism to provide the necessary parameters for image processing.
+*       adjustments to gamma correction. The menu writes the slider values into
+*       the typed, preallocated slot of a ParameterSuppressor and the worker
+*       copies them out of it, so no QVariant is built or allocated per value.
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate performImageAdjustments method prematurely. See Issue #41 for
-*       more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Adjust
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -51,56 +51,43 @@
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
 * 0.2           09/04/2019      Matthew R. Miller       Depth Fixed
+* 0.3           10/16/2026      agent                   Core Library, Color Cube
 *
 ************************************************************************/
 
 #include "adjustworker.h"
 #include "app_filters/signalsuppressor.h"
-#include "editing/menus/adjustmenu.h"
-#include <QMutex>
+#include "core/openclwarmup.h"
+#include "core/stageprofiler.h"
+#include "core/triplebuffer.h"
 #include <QString>
-#include <opencv2/imgproc.hpp>
 #include <opencv2/core/ocl.hpp>
 #include <QDebug>
-//#include <QElapsedTimer>
 
-#define HUE_DEPTH_SEPARATION 30
-#define INTENSITY_DEPTH_SEPARATION 128
-#define SATURATION_DEPTH_SEPARATION INTENSITY_DEPTH_SEPARATION
-
-/* Constructor initializes the appropriate member variables for the worker object. If
- * an OpenCL device is detected as available on the system, a pre-initialization step is
- * performed to increase initial performance. */
-AdjustWorker::AdjustWorker(const cv::Mat *masterImage, cv::Mat *previewImage, QMutex *mutex, QObject *parent)
+/* Constructor initializes the appropriate member variables for the worker object. The OpenCL
+ * pre-initialization is left to initialize so that it does not block the thread creating the worker. */
+AdjustWorker::AdjustWorker(TripleBuffer *sourceFrames, TripleBuffer *previewFrames, QObject *parent)
     : QObject(parent)
 {
-    emit updateStatus("Adjust Menu initializing...");
-    //QElapsedTimer timer;
-    //timer.start();
-    cv::Mat lookUpTable(1, 256, CV_8UC1);
-
-    //OpenCL initialization step to build the OpenCL calls in GPU before the worker is called with an attached image
-    cv::ocl::Context ctx = cv::ocl::Context::getDefault();
-    if (ctx.ptr())
-    {
-        cv::Mat tmpMat(100, 100, CV_8UC3);
-        cv::randu(tmpMat, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
-        float tmpParameters[] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-
-        mutex_m = nullptr;
-        masterImage_m = &tmpMat;
-        previewImage_m = &tmpMat;
 
-        performImageAdjustments(tmpParameters);
-    }
-
-    mutex_m = mutex;
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Adjust Worker Created! - Images:" << masterImage_m << previewImage_m;
+    sourceFrames_m = sourceFrames;
+    previewFrames_m = previewFrames;
+    //one slider is moved at a time, so only the stages after that slider are recomputed
+    processor_m.setIncremental(true);
+    cubeProcessor_m.setIncremental(true);
+    qDebug() << "Adjust Worker Created! - Frames:" << sourceFrames_m << previewFrames_m;
+}
 
-    //qDebug() << "The slow operation took" << timer.elapsed() << "milliseconds";
+/* This slot is called once the worker has been moved to its thread and the thread has started. If an
+ * OpenCL device is detected as available on the system, a pre-initialization step is performed to
+ * increase initial performance. The OpenCL calls are built once per process, so only the first worker
+ * of its kind pays for them. Emits ready once the worker can render previews without the delay.*/
+void AdjustWorker::initialize()
+{
+    emit updateStatus("Adjust Menu initializing...");
+    OpenClWarmUp::run(OpenClWarmUp::Adjust);
     emit updateStatus("");
+    emit ready();
 }
 
 // destructor
@@ -114,234 +101,60 @@ AdjustWorker::~AdjustWorker()
  * works see signalsuppressor.h/cpp. The format is tied to the associated menu object. */
 void AdjustWorker::receiveSuppressedSignal(SignalSuppressor *dataContainer)
 {
-    data_m = dataContainer->getNewData().toByteArray();
-    float *parameters = reinterpret_cast<float*>(data_m.data());
-    performImageAdjustments(parameters);
-    emit updateDisplayedImage();
-}
-
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the controlling thread. If the Mat's become empty in the controlling thread this slot
- * should be signaled with nullptrs to signify they are empty. */
-void AdjustWorker::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
-{
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Adjust Worker Images:" << masterImage_m << previewImage_m;
+    int generation;
+    AdjustProcessor::Parameters parameters =
+            static_cast<ParameterSuppressor<AdjustProcessor::Parameters>*>(dataContainer)->getNewData(&generation);
+
+    //stale work is abandoned between stages once a newer value is sent, which signals this slot again
+    processor_m.setCancelCheck([dataContainer, generation]() { return dataContainer->isSuperseded(generation); });
+    cubeProcessor_m.setCancelCheck([dataContainer, generation]() { return dataContainer->isSuperseded(generation); });
+    if(performImageAdjustments(parameters.data()))
+        emit updateDisplayedImage();
 }
 
 /* Performs the image adjustment operations from the Adjust menu in the GUI. If the images
- * exist in memory the function locks the mutex and copies the necessary parameters before
+ * exist in memory the function renders from the latest source image into the write buffer before
  * performing the desired operations only for the corresponding sliders in the .ui file that
- * have changed from their default value. Using a QVector forces a copy when passing information*/
-void AdjustWorker::performImageAdjustments(float * parameter)
+ * have changed from their default value. The parameters are read from the worker's own copy of
+ * the suppressor slot, so the menu can write the next values while they are used.*/
+bool AdjustWorker::performImageAdjustments(float * parameter)
 {
     emit updateStatus("Working...");
-    if(mutex_m) mutex_m->lock();
-    if(masterImage_m == nullptr || previewImage_m == nullptr)
+    //use the latest image published by the GUI, or the last one acquired if it has not changed
+    if(sourceFrames_m && sourceFrames_m->acquire())
+        processor_m.sourceChanged(); //cached stages belong to the previous image
+    if(sourceFrames_m == nullptr || previewFrames_m == nullptr || sourceFrames_m->readBuffer().empty())
     {
-        if(mutex_m) mutex_m->unlock();
         qDebug() << "Cannot perform Adjustments, image not attached";
         emit updateStatus("");
-        return;
-    }
-
-    //clone necessary because internal checks will prevent GUI image from cycling.
-    masterImage_m->copyTo(implicitOclImage_m);
-
-    //--perform operations on hue, intensity, and saturation color space if values are not set to initial
-    if(parameter[AdjustMenu::Hue] != 0.0f || parameter[AdjustMenu::Intensity] != 0.0f
-            || parameter[AdjustMenu::Saturation] != 0.0f || parameter[AdjustMenu::Gamma] != 1.0f
-            || parameter[AdjustMenu::Highlight] != 0.0f || parameter[AdjustMenu::Shadows] != 0.0f
-            || parameter[AdjustMenu::Depth] < 255)
-    {
-        cv::cvtColor(implicitOclImage_m, implicitOclImage_m, cv::COLOR_RGB2HLS);
-        cv::split(implicitOclImage_m, splitChannelsTmp_m);
-
-        /* openCv hue is stored as 360/2 since uchar cannot store above 255 so a LUT is populated
-             * from 0 to 180 and phase shifted between -180 and 180 based on slider input. */
-        if(parameter[AdjustMenu::Hue] != 0.0f)
-        {
-            //populate LUT to map the current values to correct phase (only 180 cells used)
-            int hueShifted;
-            cv::Mat lookUpTable(1, 256, CV_8UC1);
-            for(int i = 0; i < 180; i++)
-            {
-                hueShifted = i + parameter[AdjustMenu::Hue];
-                if(hueShifted < 0)
-                    hueShifted += 180;
-                else if(hueShifted > 179)
-                    hueShifted -=180;
-                lookUpTable.data[i] = hueShifted;
-            }
-            cv::LUT(splitChannelsTmp_m.at(0), lookUpTable, splitChannelsTmp_m[0]);
-        }
-
-        //adjust the intensity
-        if(parameter[AdjustMenu::Intensity] != 0.0f)
-            splitChannelsTmp_m.at(1).convertTo(splitChannelsTmp_m[1], -1, 1.0, parameter[AdjustMenu::Intensity]);
-
-        //adjust the saturation
-        if(parameter[AdjustMenu::Saturation] != 0.0f)
-            splitChannelsTmp_m.at(2).convertTo(splitChannelsTmp_m[2], -1, 1.0, parameter[AdjustMenu::Saturation]);
-
-        //adjust gamma by 255(i/255)^(1/gamma) where gamma 0.5 to 3.0
-        if(parameter[AdjustMenu::Gamma] != 1.0f || parameter[AdjustMenu::Highlight] != 0.0f
-                || parameter[AdjustMenu::Shadows] != 0.0f)
-        {
-            //fill LUT for gamma adjustment
-            cv::Mat lookUpTable(1, 256, CV_8UC1);
-            float tmpGamma;
-            for(int i = 0; i < 256; i++)
-            {
-                //adjust gamma
-                tmpGamma = 255.0f * powf(i / 255.0f, 1.0f / parameter[AdjustMenu::Gamma]);
-
-                /* Bound the shadow adjustment to all pixels below 149 such that the x axis is not
-                     * crossed (output is not fliped) in the adjustment equation -(x/50.0)^4 + x and is
-                     * handled as a step function. Function is deisned to taper towards zero as the bound
-                     * is approached in conjunction with the highlight adjustment. Equation inverted for
-                     * subtraction. Shadow operates on the gamma adjusted LUT from a range of -80 to 80*/
-                if(i < 149 && parameter[AdjustMenu::Shadows] != 0.0f)
-                {
-                    float tmpShadow;
-                    if(parameter[AdjustMenu::Shadows] > 0.0f)
-                    {
-                        //-(x/50.0)^4 + shadow
-                        tmpShadow = -1 * powf(i / 50.0f, 4) + parameter[AdjustMenu::Shadows];
-                        if(tmpShadow > 0)
-                            tmpGamma += tmpShadow;
-                    }
-                    else
-                    {
-                        //(x/50.0)^4 - shadow .. (shadow is negative)
-                        tmpShadow = powf(i / 50.0f, 4) + parameter[AdjustMenu::Shadows];
-                        if(tmpShadow < 0)
-                            tmpGamma += tmpShadow;
-                    }
-                }
-
-                /* Bound the highlight adjustment to all pixels above 106 such that the x axis is not
-                     * crossed (output is not fliped) in the adjustment equation -(x/50.0 - 5.1)^4 + x and is
-                     * handled as a step function. Function is deisned to taper towards zero as the bound
-                     * is approached in conjunction with the highlight adjustment.Equation inverted for
-                     * subtraction. Highlight operates on the gamma adjusted LUT from a range of -80 to 80*/
-                if(i > 106 && parameter[AdjustMenu::Highlight] != 0.0f)
-                {
-                    float tmpHighlight;
-                    if(parameter[AdjustMenu::Highlight] > 0.0f)
-                    {
-                        //-(x/50.0 - 5.1)^4 + highlight
-                        tmpHighlight = -1 * powf(i / 50.0f - 5.1f, 4) + parameter[AdjustMenu::Highlight];
-                        if(tmpHighlight > 0)
-                            tmpGamma += tmpHighlight;
-                    }
-                    else
-                    {
-                        //(x/50.0 - 5.1)^4 - highlight .. (highlight is negative)
-                        tmpHighlight = powf(i / 50.0f - 5.1f, 4) + parameter[AdjustMenu::Highlight];
-                        if(tmpHighlight < 0)
-                            tmpGamma += tmpHighlight;
-                    }
-                }
-
-                //limit gamma adjusted values
-                if(tmpGamma > 255)
-                    tmpGamma = 255;
-                else if(tmpGamma < 0)
-                    tmpGamma = 0;
-
-                lookUpTable.data[i] = tmpGamma;
-            }
-
-            //replace pixel values based on their LUT value
-            cv::LUT(splitChannelsTmp_m.at(1), lookUpTable, splitChannelsTmp_m[1]);
-        }
-
-        //--adjust the number of colors available of not at initial value of 255
-        if(parameter[AdjustMenu::Depth] < 255)
-        {
-            //create and normalize LUT for 0 to 180 for Hue; replace pixel intensities based on their LUT value
-            cv::Mat lookUpTable(1, 256, CV_8UC1);
-            float scaleFactor = 1.0f - (parameter[AdjustMenu::Depth] * (180.0f / 255.0f)) / 180.0f;
-            int mod;
-            for(int i = 0; i < 180; i++)
-            {
-                /*if color is closer to the lower hue separation level than the higher hue separation level in radians
-                  (scaled by half for OpenCV - 180 not 360), scale towards the lower level, else scale towards the higher level */
-                mod = (i + 1) % HUE_DEPTH_SEPARATION;
-                if( mod <= HUE_DEPTH_SEPARATION / 2)
-                {
-                    lookUpTable.data[i] = static_cast<uchar>(static_cast<float>(i + 1) - roundf(mod * scaleFactor));
-                    //qDebug() << "Data %30 =< 15 : " << lookUpTable_m.data[i];
-                }
-                else
-                {
-                    lookUpTable.data[i] = static_cast<uchar>(static_cast<float>(i + 1) + roundf(((HUE_DEPTH_SEPARATION - mod) * scaleFactor) ));
-                    //qDebug() << "Data %30 > 15 : " << lookUpTable_m.data[i];
-                }
-            }
-            cv::LUT(splitChannelsTmp_m.at(0), lookUpTable, splitChannelsTmp_m[0]);
-
-            //create and normalize LUT from 0 to largest intensity / saturation values, then scale from 0 to 255
-            float tmp;
-            scaleFactor = 1.0f - (parameter[AdjustMenu::Depth] / 255.0f);
-            for(int i = 0; i < 256; i++)
-            {
-                /*if color is closer to the lower hue separation level than the higher saturation separation level in 255 scaled value;
-                  scale towards the lower level, else scale towards the higher level */
-                mod = (i + 1) % INTENSITY_DEPTH_SEPARATION;
-                if( mod <= INTENSITY_DEPTH_SEPARATION / 2)
-                {
-                    tmp = static_cast<float>(i + 1) - roundf(mod * scaleFactor);
-                    if(tmp > 255.0f)
-                        tmp = 255.0f;
-                    lookUpTable.data[i] = static_cast<uchar>(tmp);
-                    //qDebug() << "Data %128 =< 64 : " << lookUpTable_m.data[i];
-                }
-                else
-                {
-                    lookUpTable.data[i] = static_cast<uchar>(static_cast<float>(i + 1) + floorf(((INTENSITY_DEPTH_SEPARATION - mod) * scaleFactor) ));
-                    //qDebug() << "Data %128 > 64 : " << lookUpTable_m.data[i];
-                }
-            }
-            cv::LUT(splitChannelsTmp_m.at(1), lookUpTable, splitChannelsTmp_m[1]); //sat
-            //cv::LUT(splitChannelsTmp_m.at(2), lookUpTable_m, splitChannelsTmp_m[2]); //int
-        }
-        cv::merge(splitChannelsTmp_m, implicitOclImage_m);
-        cv::cvtColor(implicitOclImage_m, implicitOclImage_m, cv::COLOR_HLS2RGB);
+        return false;
     }
 
-
-    //--convert from color to grayscale if != 1.0
-    if(parameter[AdjustMenu::Color] != 1.0f)
+    /* If the color cube preview is enabled and there is no OpenCL, the operation is baked into a color
+     * cube, which costs the same for any image size, and the cube is applied to the image with one look
+     * up per pixel so that tracking stays responsive. The cube only approximates the operation, so that
+     * frame is published without its operation and the edit is rendered exactly when it is applied. The
+     * cube would blend the steps of the depth quantization, so a reduced depth is always rendered exactly.*/
+    bool rendered;
+    EditOperation operation{};
+    if(cv::ocl::useOpenCL() || !ColorCube::previewEnabled() || parameter[AdjustProcessor::Depth] < 255)
     {
-        cv::cvtColor(implicitOclImage_m, splitChannelsTmp_m[0], cv::COLOR_RGB2GRAY);
-        splitChannelsTmp_m.at(0).copyTo(splitChannelsTmp_m.at(1));
-        splitChannelsTmp_m.at(0).copyTo(splitChannelsTmp_m.at(2));
-        cv::merge(splitChannelsTmp_m, implicitOclImage_m);
+        rendered = processor_m.process(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer(), parameter);
+        operation.type = EditOperation::Adjust;
+        std::copy(parameter, parameter + AdjustProcessor::ParameterCount, operation.adjustParameters);
     }
-
-
-    //--perform contrast and brightness operation if sliders are not at initial positions
-    if (parameter[AdjustMenu::Brightness] != 0.0f || parameter[AdjustMenu::Contrast] != 1.0f)
+    else
     {
-        float alpha = parameter[AdjustMenu::Contrast];
-        float beta = parameter[AdjustMenu::Brightness];
-
-        //calculate brightness correction
-        if(alpha >= 1)
-            beta += -72.8f * log2f(alpha);
-        else
-            beta += 127.0f * -log2f(alpha) / sqrtf(1 / alpha);
-
-        //perform contrast computation and prime source buffer
-        implicitOclImage_m.convertTo(implicitOclImage_m, -1, alpha, beta);
+        rendered = colorCube_m.bake([this, parameter](const cv::Mat &lattice, cv::Mat &baked) {
+            return cubeProcessor_m.process(lattice, baked, parameter);
+        });
+        if(rendered)
+            colorCube_m.apply(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer());
     }
 
-    implicitOclImage_m.copyTo(*previewImage_m);
-
-    //after computation is complete, push image and histogram to GUI if changes were made
-    if(mutex_m) mutex_m->unlock();
+    //after computation is complete, publish the preview so the GUI can display the latest frame
+    if(rendered)
+        previewFrames_m->publish(operation);
     emit updateStatus("");
+    return rendered;
 }
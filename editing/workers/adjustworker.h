@@ -31,17 +31,17 @@
 *       This is the worker thread object tied to the adjustmenu.cpp object.
 *       The worker performs the operations for adjusting the color, brightness,
 *       contrast, pixel depth, hue, saturation, intensity including high and low
-*       adjustments to gamma correction. It collects all necessary slider
-*       values in a QVarient and copies the object through the signal/signal
-*       mechanism to provide the necessary parameters for image processing.
+*       adjustments to gamma correction. The menu writes the slider values into
+*       the typed, preallocated slot of a ParameterSuppressor and the worker
+*       copies them out of it, so no QVariant is built or allocated per value.
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate performImageAdjustments method prematurely. See Issue #41 for
-*       more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Adjust
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -51,6 +51,7 @@
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
 * 0.2           09/04/2019      Matthew R. Miller       Depth Fixed
+* 0.3           10/16/2026      agent                   Core Library, Color Cube
 *
 ************************************************************************/
 
@@ -58,9 +59,10 @@
 #define ADJUSTWORKER_H
 
 #include <QObject>
-#include <QByteArray>
 #include <opencv2/core.hpp>
-class QMutex;
+#include "../../core/adjustprocessor.h"
+#include "../../core/colorcube.h"
+class TripleBuffer;
 class QString;
 class SignalSuppressor;
 
@@ -68,25 +70,25 @@ class AdjustWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit AdjustWorker(const cv::Mat *masterImage = nullptr, cv::Mat *previewImage = nullptr, QMutex *mutex = nullptr, QObject *parent = nullptr);
+    explicit AdjustWorker(TripleBuffer *sourceFrames = nullptr, TripleBuffer *previewFrames = nullptr, QObject *parent = nullptr);
     ~AdjustWorker();
 
 signals:
     void updateDisplayedImage();
     void updateStatus(QString);
+    void ready();
 
 public slots:
+    void initialize();
     void receiveSuppressedSignal(SignalSuppressor *dataContainer);
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
 
 private:
-    void performImageAdjustments(float *parameter);
-    QByteArray data_m;
-    QMutex *mutex_m;
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    cv::UMat implicitOclImage_m;
-    std::vector <cv::UMat> splitChannelsTmp_m;
+    bool performImageAdjustments(float *parameter);
+    TripleBuffer *sourceFrames_m;
+    TripleBuffer *previewFrames_m;
+    AdjustProcessor processor_m;
+    AdjustProcessor cubeProcessor_m; //bakes the color cube, so its cached stages always belong to the lattice
+    ColorCube colorCube_m;
 };
 
 #endif // ADJUSTWORKER_H
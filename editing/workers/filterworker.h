@@ -30,9 +30,9 @@
 * DESCRIPTION :
 *       This is the worker thread object tied to the filtermenu.cpp object.
 *       The worker performs the operations for filtering the image such as
-*       sharpening, bluring, and edge detect. It collects all necessary slider
-*       values in a QVarient and copies the object through the signal/signal
-*       mechanism to provide the necessary parameters for image processing.
+*       sharpening, bluring, and edge detect. The menu writes the slider values
+*       into the typed, preallocated slot of a ParameterSuppressor and the worker
+*       copies them out of it, so no QVariant is built or allocated per value.
 *
 * NOTES :
 *       This worker thread does not use the OpenCL enhancements offered implicitly
@@ -46,15 +46,16 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/08/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Core Library, Triple Buffers
 *
 ************************************************************************/
 #ifndef FILTERWORKER_H
 #define FILTERWORKER_H
 
 #include <QObject>
-#include <QByteArray>
 #include <opencv2/core.hpp>
-class QMutex;
+#include "../../core/filterprocessor.h"
+class TripleBuffer;
 class QString;
 class SignalSuppressor;
 
@@ -62,26 +63,23 @@ class FilterWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit FilterWorker(const cv::Mat *masterImage = nullptr, cv::Mat *previewImage = nullptr, QMutex *mutex = nullptr, QObject *parent = nullptr);
+    explicit FilterWorker(TripleBuffer *sourceFrames = nullptr, TripleBuffer *previewFrames = nullptr, QObject *parent = nullptr);
     ~FilterWorker();
 
 signals:
     void updateDisplayedImage();
     void updateStatus(QString);
+    void ready();
 
 public slots:
+    void initialize();
     void receiveSuppressedSignal(SignalSuppressor *dataContainer);
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
 
 private:
-    void performImageFiltering(int *parameter);
-    int kernelSize(QSize image, int weightPercent);
-    cv::Mat makeLaplacianKernel(int size);
-    QByteArray data_m;
-    QMutex *mutex_m;
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    cv::Mat tmpImage_m;
+    bool performImageFiltering(int *parameter);
+    TripleBuffer *sourceFrames_m;
+    TripleBuffer *previewFrames_m;
+    FilterProcessor processor_m;
 };
 
 #endif // FILTERWORKER_H
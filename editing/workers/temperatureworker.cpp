@@ -30,17 +30,17 @@
 * DESCRIPTION :
 *       This is the worker thread object tied to the temperaturemenu.cpp object.
 *       The worker performs the operations for adjusting the lighting temperature.
-*       It transmits the temperature value in a QVarient and copies the object
-*       through the signal/signal mechanism to provide the necessary parameters
-*       for image processing.
+*       The menu writes the temperature value into the typed, preallocated slot
+*       of a ParameterSuppressor and the worker copies it out of it, so no
+*       QVariant is built or allocated per value.
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate performImageAdjustments method prematurely. See Issue #41 for
-*       more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Temperature
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -49,42 +49,37 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Core Library, Color Cube
 *
 ************************************************************************/
 #include "temperatureworker.h"
 #include "../../app_filters/signalsuppressor.h"
-#include <QMutex>
+#include "../../core/openclwarmup.h"
+#include "../../core/stageprofiler.h"
+#include "../../core/triplebuffer.h"
 #include <QString>
-#include <opencv2/imgproc.hpp>
 #include <opencv2/core/ocl.hpp>
 #include <QDebug>
 
-TemperatureWorker::TemperatureWorker(const cv::Mat *masterImage, cv::Mat *previewImage, QMutex *mutex, QObject *parent)
+TemperatureWorker::TemperatureWorker(TripleBuffer *sourceFrames, TripleBuffer *previewFrames, QObject *parent)
     : QObject(parent)
 {
-    emit updateStatus("Temperature Menu initializing...");
-
-    //OpenCL initialization step to build the OpenCL calls in GPU before the worker is called with an attached image
-    cv::ocl::Context ctx = cv::ocl::Context::getDefault();
-    if (ctx.ptr())
-    {
-        cv::Mat tmpMat(100, 100, CV_8UC3);
-        cv::randu(tmpMat, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
-        int tmpParameters = 0;
-
-        mutex_m = nullptr;
-        masterImage_m = &tmpMat;
-        previewImage_m = &tmpMat;
-
-        performLampTemperatureShift(tmpParameters);
-    }
 
-    mutex_m = mutex;
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Temperature Worker Created! - Images:" << masterImage_m << previewImage_m;
+    sourceFrames_m = sourceFrames;
+    previewFrames_m = previewFrames;
+    qDebug() << "Temperature Worker Created! - Frames:" << sourceFrames_m << previewFrames_m;
+}
 
+/* This slot is called once the worker has been moved to its thread and the thread has started. If an
+ * OpenCL device is detected as available on the system, a pre-initialization step is performed to
+ * increase initial performance. The OpenCL calls are built once per process, so only the first worker
+ * of its kind pays for them. Emits ready once the worker can render previews without the delay.*/
+void TemperatureWorker::initialize()
+{
+    emit updateStatus("Temperature Menu initializing...");
+    OpenClWarmUp::run(OpenClWarmUp::Temperature);
     emit updateStatus("");
+    emit ready();
 }
 
 TemperatureWorker::~TemperatureWorker()
@@ -97,77 +92,52 @@ TemperatureWorker::~TemperatureWorker()
  * works see signalsuppressor.h/cpp. The format is tied to the associated menu object. */
 void TemperatureWorker::receiveSuppressedSignal(SignalSuppressor *dataContainer)
 {
-    data_m = dataContainer->getNewData().toInt();
-    performLampTemperatureShift(data_m);
-    emit updateDisplayedImage();
-}
+    int generation;
+    data_m = static_cast<ParameterSuppressor<int>*>(dataContainer)->getNewData(&generation);
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the controlling thread. If the Mat's become empty in the controlling thread this slot
- * should be signaled with nullptrs to signify they are empty. */
-void TemperatureWorker::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
-{
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Adjust Worker Images:" << masterImage_m << previewImage_m;
+    //stale work is abandoned between stages once a newer value is sent, which signals this slot again
+    processor_m.setCancelCheck([dataContainer, generation]() { return dataContainer->isSuperseded(generation); });
+    if(performLampTemperatureShift(data_m))
+        emit updateDisplayedImage();
 }
 
 
-void TemperatureWorker::performLampTemperatureShift(int parameter)
+bool TemperatureWorker::performLampTemperatureShift(int parameter)
 {
     emit updateStatus("Working...");
-    if(mutex_m) mutex_m->lock();
-    if(masterImage_m == nullptr || previewImage_m == nullptr)
+    //use the latest image published by the GUI, or the last one acquired if it has not changed
+    if(sourceFrames_m) sourceFrames_m->acquire();
+    if(sourceFrames_m == nullptr || previewFrames_m == nullptr || sourceFrames_m->readBuffer().empty())
     {
-        if(mutex_m) mutex_m->unlock();
         qDebug() << "Cannot perform Adjustments, image not attached";
         emit updateStatus("");
-        return;
+        return false;
     }
 
-    //clone necessary because internal checks will prevent GUI image from cycling.
-    masterImage_m->copyTo(implicitOclImage_m);
-
-    float yred, ygreen, yblue;
-    double x = parameter / 100.0;
-
-    //step function for red and green channels
-    if(parameter > 6500)
+    /* If the color cube preview is enabled and there is no OpenCL, the operation is baked into a color
+     * cube, which costs the same for any image size, and the cube is applied to the image with one look
+     * up per pixel so that tracking stays responsive. The cube only approximates the operation, so that
+     * frame is published without its operation and the edit is rendered exactly when it is applied.*/
+    bool rendered;
+    EditOperation operation{};
+    if(cv::ocl::useOpenCL() || !ColorCube::previewEnabled())
     {
-        yred = 479.7143 - 4.757143 * x + 0.02 * pow(x, 2);
-        ygreen = 369.3214 - 2.502381 * x + 0.01 * pow(x, 2);
+        rendered = processor_m.process(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer(), parameter);
+        operation.type = EditOperation::Temperature;
+        operation.value = parameter;
     }
     else
     {
-        yred = 255.0;
-        ygreen = -50.34577 + 13.21698 * x - 0.2250017 * pow(x, 2.0) + 0.001430717 * pow(x, 3.0);
-    }
-
-    //step function for blue channel
-    if(parameter < 1500)
-    {
-        yblue = 0.0;
-    }
-    else if(parameter > 7000)
-    {
-        yblue = 255.0;
+        rendered = colorCube_m.bake([this, parameter](const cv::Mat &lattice, cv::Mat &baked) {
+            return processor_m.process(lattice, baked, parameter);
+        });
+        if(rendered)
+            colorCube_m.apply(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer());
     }
-    else
-    {
-        yblue = 260.1294 - 51.0587 * x + 3.321611 * pow(x, 2.0) - 0.08684615 * pow(x, 3.0)
-                + 0.001048834 * pow(x, 4.0) - 0.000004820513 * pow(x, 5.0);
-    }
-
-    //split each channel and manipulate each channel individually
-    cv::split(implicitOclImage_m, splitChannelsTmp_m);
-    splitChannelsTmp_m.at(0) = splitChannelsTmp_m.at(0).mul(yred / 255);
-    splitChannelsTmp_m.at(1) = splitChannelsTmp_m.at(1).mul(ygreen / 255);
-    splitChannelsTmp_m.at(2) = splitChannelsTmp_m.at(2).mul(yblue / 255);
-    cv::merge(splitChannelsTmp_m, implicitOclImage_m);
-
-    implicitOclImage_m.copyTo(*previewImage_m);
 
-    //after computation is complete, push image and histogram to GUI if changes were made
-    if(mutex_m) mutex_m->unlock();
+    //after computation is complete, publish the preview so the GUI can display the latest frame
+    if(rendered)
+        previewFrames_m->publish(operation);
     emit updateStatus("");
+    return rendered;
 }
@@ -30,17 +30,17 @@
 * DESCRIPTION :
 *       This is the worker thread object tied to the temperaturemenu.cpp object.
 *       The worker performs the operations for adjusting the lighting temperature.
-*       It transmits the temperature value in a QVarient and copies the object
-*       through the signal/signal mechanism to provide the necessary parameters
-*       for image processing.
+*       The menu writes the temperature value into the typed, preallocated slot
+*       of a ParameterSuppressor and the worker copies it out of it, so no
+*       QVariant is built or allocated per value.
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate performImageAdjustments method prematurely. See Issue #41 for
-*       more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Temperature
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -49,6 +49,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Core Library, Color Cube
 *
 ************************************************************************/
 #ifndef TEMPERATUREWORKER_H
@@ -56,7 +57,9 @@
 
 #include <QObject>
 #include <opencv2/core.hpp>
-class QMutex;
+#include "../../core/temperatureprocessor.h"
+#include "../../core/colorcube.h"
+class TripleBuffer;
 class QString;
 class SignalSuppressor;
 
@@ -64,25 +67,25 @@ class TemperatureWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit TemperatureWorker(const cv::Mat *masterImage = nullptr, cv::Mat *previewImage = nullptr, QMutex *mutex = nullptr, QObject *parent = nullptr);
+    explicit TemperatureWorker(TripleBuffer *sourceFrames = nullptr, TripleBuffer *previewFrames = nullptr, QObject *parent = nullptr);
     ~TemperatureWorker();
 
 signals:
     void updateDisplayedImage();
     void updateStatus(QString);
+    void ready();
 
 public slots:
+    void initialize();
     void receiveSuppressedSignal(SignalSuppressor *dataContainer);
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
 
 private:
-    void performLampTemperatureShift(int parameter);
+    bool performLampTemperatureShift(int parameter);
     int data_m;
-    QMutex *mutex_m;
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    cv::UMat implicitOclImage_m;
-    std::vector <cv::UMat> splitChannelsTmp_m;
+    TripleBuffer *sourceFrames_m;
+    TripleBuffer *previewFrames_m;
+    TemperatureProcessor processor_m;
+    ColorCube colorCube_m;
 };
 
 #endif // TEMPERATUREWORKER_H
@@ -33,10 +33,11 @@
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate method prematurely. See Issue #41 for more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Transform
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -45,43 +46,37 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Core Library, Triple Buffers
 *
 ************************************************************************/
 #include "transformworker.h"
-#include <QMutex>
 #include <QString>
 #include <QRect>
-#include <opencv2/imgproc.hpp>
-#include <opencv2/core/ocl.hpp>
 #include "../../app_filters/signalsuppressor.h"
+#include "../../core/openclwarmup.h"
+#include "../../core/stageprofiler.h"
+#include "../../core/triplebuffer.h"
 #include <QDebug>
 
-TransformWorker::TransformWorker(const cv::Mat *masterImage, cv::Mat *previewImage, QMutex *mutex, QObject *parent) : QObject(parent)
+TransformWorker::TransformWorker(TripleBuffer *sourceFrames, TripleBuffer *previewFrames, QObject *parent) : QObject(parent)
 {
-    emit updateStatus("Transform Menu initializing...");
     autoCropforRotate_m = false;
 
-    //OpenCL initialization step to build the OpenCL calls in GPU before the worker is called with an attached image
-    cv::ocl::Context ctx = cv::ocl::Context::getDefault();
-    if (ctx.ptr())
-    {
-        cv::Mat tmpMat(100, 100, CV_8UC3);
-        cv::randu(tmpMat, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
-
-        mutex_m = nullptr;
-        masterImage_m = &tmpMat;
-        previewImage_m = &tmpMat;
-
-        doRotateComputation(45);
-    }
-
-    mutex_m = mutex;
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Transform Worker Created! - Images:" << masterImage_m << previewImage_m;
+    sourceFrames_m = sourceFrames;
+    previewFrames_m = previewFrames;
+    qDebug() << "Transform Worker Created! - Frames:" << sourceFrames_m << previewFrames_m;
+}
 
+/* This slot is called once the worker has been moved to its thread and the thread has started. If an
+ * OpenCL device is detected as available on the system, a pre-initialization step is performed to
+ * increase initial performance. The OpenCL calls are built once per process, so only the first worker
+ * of its kind pays for them. Emits ready once the worker can render previews without the delay.*/
+void TransformWorker::initialize()
+{
+    emit updateStatus("Transform Menu initializing...");
+    OpenClWarmUp::run(OpenClWarmUp::Transform);
     emit updateStatus("");
-
+    emit ready();
 }
 
 // destructor
@@ -90,36 +85,33 @@ TransformWorker::~TransformWorker()
     qDebug() << "TransformWorker destroyed";
 }
 
-/* This slot is used to update the member addresses for the master and preview images stored
- * in the controlling thread. If the Mat's become empty in the controlling thread this slot
- * should be signaled with nullptrs to signify they are empty. */
-void TransformWorker::receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage)
-{
-    masterImage_m = masterImage;
-    previewImage_m = previewImage;
-    qDebug() << "Transform Worker Images:" << masterImage_m << previewImage_m;
-}
-
 /* This member (slot) recieves the data from the controlling class (slow thread). The data
  * is sent as a pointer to the class itself who's member contains the data. To see how this
  * works see signalsuppressor.h/cpp. The format is tied to the associated menu object. */
 void TransformWorker::receiveRotateSuppressedSignal(SignalSuppressor *dataContainer)
 {
-    doRotateComputation(dataContainer->getNewData().toInt());
-    emit updateDisplayedImage();
+    int generation;
+    int degree = static_cast<ParameterSuppressor<int>*>(dataContainer)->getNewData(&generation);
+
+    //stale work is abandoned between stages once a newer value is sent, which signals this slot again
+    processor_m.setCancelCheck([dataContainer, generation]() { return dataContainer->isSuperseded(generation); });
+    bool rendered = doRotateComputation(degree);
+    processor_m.setCancelCheck(nullptr);
+    if(rendered)
+        emit updateDisplayedImage();
 }
 
 /* This slot performs a cropping computation on the image. It is passed a ROI, which is assumed
- * to already be in bounds from the signal, assigns the new ROI to the dstRGBImage_m buffer. The
- * postImageOperationMutex is not used as the image on screen should not be updated (signal) until
- * the crop selection is complete according to the user so that adjustments to the ROI can be made.*/
+ * to already be in bounds from the signal, and publishes the new ROI as the preview frame. The
+ * image on screen is not updated (signal) until the crop selection is complete according to the
+ * user so that adjustments to the ROI can be made. A frame is only published if it was rendered.*/
 void TransformWorker::doCropComputation(QRect roi)
 {
     emit updateStatus("Working...");
-    if(mutex_m) mutex_m->lock();
-    if(masterImage_m == nullptr || previewImage_m == nullptr)
+    //use the latest image published by the GUI, or the last one acquired if it has not changed
+    if(sourceFrames_m) sourceFrames_m->acquire();
+    if(sourceFrames_m == nullptr || previewFrames_m == nullptr || sourceFrames_m->readBuffer().empty())
     {
-        if(mutex_m) mutex_m->unlock();
         qDebug() << "Cannot perform Crop, image not attached";
         emit updateStatus("");
         return;
@@ -129,13 +121,15 @@ void TransformWorker::doCropComputation(QRect roi)
 
     //catch exeception and display so doesnt crash
     try {
-        *previewImage_m = cv::Mat(*masterImage_m, region);
+        processor_m.crop(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer(), region);
+        EditOperation operation{};
+        operation.type = EditOperation::Crop;
+        operation.region = region;
+        previewFrames_m->publish(operation);
     } catch (cv::Exception e) {
         emit handleExceptionMessage(QString::fromStdString(e.msg));
     }
 
-    //after computation is complete, push image and histogram to GUI if changes were made
-    if(mutex_m) mutex_m->unlock();
     emit updateStatus("");
 }
 
@@ -143,165 +137,36 @@ void TransformWorker::doCropComputation(QRect roi)
  * number of degrees to rotate the image. After the image is rotated using an adjusted rotation matrix,
  * the new image is warped to fit inside the rectangular boundary of the rotated region. If auto-crop is
  * enabled the method attempts to crop the image after rotation to a useful size within the rotated region,
- * but excluding any black corners that were not part of the original image. In the notes a suggestion for
- * a better solution is discussed for a further update */
-void TransformWorker::doRotateComputation(int degree)
+ * but excluding any black corners that were not part of the original image. See TransformProcessor::rotate.*/
+bool TransformWorker::doRotateComputation(int degree)
 {
     emit updateStatus("Working...");
-    if(mutex_m) mutex_m->lock();
-    if(masterImage_m == nullptr || previewImage_m == nullptr)
+    //use the latest image published by the GUI, or the last one acquired if it has not changed
+    if(sourceFrames_m) sourceFrames_m->acquire();
+    if(sourceFrames_m == nullptr || previewFrames_m == nullptr || sourceFrames_m->readBuffer().empty())
     {
-        if(mutex_m) mutex_m->unlock();
         qDebug() << "Cannot perform Rotate, image not attached";
-        return;
+        return false;
     }
 
-    //clone necessary because internal checks will prevent GUI image from cycling.
-    masterImage_m->copyTo(implicitOclImage_m);
-
-    //center of rotation, rotation matrix, and containing size for rotation
-    degree *= -1;
-    cv::Point2f center = cv::Point2f((masterImage_m->cols -1) / 2.0, (masterImage_m->rows -1) / 2.0);
-    cv::Mat rotationMatrix = cv::getRotationMatrix2D(center, degree, 1);
-    cv::RotatedRect rotatedRegion(center, masterImage_m->size(), degree);
-    cv::Rect boundingRegion = rotatedRegion.boundingRect();
-
-    //adjust the rotation matrix
-    rotationMatrix.at<double>(0, 2) += boundingRegion.width / 2.0 - masterImage_m->cols / 2.0;
-    rotationMatrix.at<double>(1, 2) += boundingRegion.height / 2.0 - masterImage_m->rows / 2.0;
-
     //catch exeception and display so doesnt crash
+    bool rendered = false;
     try {
-        cv::UMat(boundingRegion.size(), masterImage_m->type()).copyTo(previewImplicitOclImage_m);
-        cv::warpAffine(implicitOclImage_m, previewImplicitOclImage_m, rotationMatrix, boundingRegion.size());
-    } catch (cv::Exception e) {
-        emit handleExceptionMessage(QString::fromStdString(e.msg));
-    }
-
-    /* crop image so that no black edges due to rotation are showing if not square
-     * NOTE: maybe in a later update use the opposite line equations here to calculate the optimal position
-     * of image within the original frame, then warp to fit instead of trying to adjust the frame to the
-     * optimal size within the rotated region*/
-    if(autoCropforRotate_m && degree != 0 && abs(degree) != 90 && abs(degree) != 180)
-    {
-        cv::Point2f corners[4];
-        rotatedRegion.points(corners);
-
-        //offset for points in boundingRegion
-        for(int i = 0; i < 4; i ++)
-        {
-            corners[i].x += boundingRegion.width / 2.0 - masterImage_m->cols / 2.0;
-            corners[i].y += boundingRegion.height / 2.0 - masterImage_m->rows / 2.0;
-        }
-
-        //determine which points are which on the rotated image
-        cv::Point2f *top = &corners[0];
-        cv::Point2f *bottom = &corners[0];
-        cv::Point2f *left = &corners[0];
-        cv::Point2f *right = &corners[0];
-
-        //find position-most point of rotated rect
-        for(int i = 0; i < 4; i++) //one loop, set initial values first
-        {
-            //should not be called if points are square (ignore bounding case for now)
-            if(top->y < corners[i].y)
-                top = &corners[i];
-            if(bottom->y > corners[i].y)
-                bottom = &corners[i];
-            if(left->x > corners[i].x)
-                left = &corners[i];
-            if(right->x < corners[i].x)
-                right = &corners[i];
-        }
-        //points are flipped in rotatedRegion.points() call (something weird with corners on rotate)
-        std::swap(right->y, left->y);
-        std::swap(top->y, bottom->y);
-
-        //for testing purposes to visualize points (good place to visualize points if debugging)
-        qDebug() << "T:"<< top->x << top->y << "B:" << bottom->x << bottom->y << "L:" << left->x << left->y << "R:" << right->x << right->y;
-
-        //bottom lines are parallel
-        double slopeTopLeft = (top->y - left->y) / (top->x - left->x);
-        double slopeTopRight = (top->y - right->y) / (top->x - right->x);
-
-        //find line intercepts for each side (y is inverted for lower intercepts so they are adjusted accordingly)
-        double yInterceptTopLeft = -1 * (slopeTopLeft * top->x);
-        double yInterceptTopRight = -1 * (slopeTopRight * top->x);
-        double yInterceptBottomLeft = left->y;
-        double yInterceptBottomRight = -1 * (slopeTopLeft * bottom->x) + boundingRegion.height;
-
-        //find point on opposite intercepting lines from image corners straight up or across
-        cv::Point2f interceptOppositeOfTopCorner;
-        cv::Point2f interceptOppositeOfBottomCorner;
-        cv::Point2f interceptOppositeOfLeftCorner;
-        cv::Point2f interceptOppositeOfRightCorner;
-
-        //calculates the intercepts on the edge of the rectangle opposite its corners
-        interceptOppositeOfBottomCorner.x = bottom->x;
-        interceptOppositeOfTopCorner.x = top->x;
-        if(top->x < bottom->x)
-        {
-            interceptOppositeOfBottomCorner.y = slopeTopRight * interceptOppositeOfBottomCorner.x + yInterceptTopRight;
-            interceptOppositeOfTopCorner.y = slopeTopRight * interceptOppositeOfTopCorner.x + yInterceptBottomLeft;
-        }
-        else
+        rendered = processor_m.rotate(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer(), degree, autoCropforRotate_m);
+        if(rendered)
         {
-            interceptOppositeOfBottomCorner.y = slopeTopLeft * interceptOppositeOfBottomCorner.x + yInterceptTopLeft;
-            interceptOppositeOfTopCorner.y = slopeTopLeft * interceptOppositeOfTopCorner.x + yInterceptBottomRight;
+            EditOperation operation{};
+            operation.type = EditOperation::Rotate;
+            operation.value = degree;
+            operation.autoCrop = autoCropforRotate_m;
+            previewFrames_m->publish(operation);
         }
-
-        interceptOppositeOfRightCorner.y = right->y;
-        interceptOppositeOfLeftCorner.y = left->y;
-        if(left->y < right->y)
-        {
-            interceptOppositeOfLeftCorner.x = (interceptOppositeOfLeftCorner.y - yInterceptTopRight) / slopeTopRight;
-            interceptOppositeOfRightCorner.x = (interceptOppositeOfRightCorner.y - yInterceptBottomLeft) / slopeTopRight;
-        }
-        else
-        {
-            interceptOppositeOfLeftCorner.x = (interceptOppositeOfLeftCorner.y - yInterceptBottomRight) / slopeTopLeft;
-            interceptOppositeOfRightCorner.x = (interceptOppositeOfRightCorner.y - yInterceptTopLeft) / slopeTopLeft;
-        }//(good place to visualize points if debugging)
-
-
-        //using the location of the opposite intercept points, attempt to create a ROI large as possible while excluding black edges
-        double x, y, width, height;
-        if(interceptOppositeOfTopCorner.x < interceptOppositeOfBottomCorner.x)
-        {
-            x = (interceptOppositeOfRightCorner.x + interceptOppositeOfTopCorner.x) / 2.0;
-            width = (interceptOppositeOfLeftCorner.x + interceptOppositeOfBottomCorner.x) / 2.0 - x;
-        }
-        else
-        {
-            x = (interceptOppositeOfRightCorner.x + interceptOppositeOfBottomCorner.x) / 2.0;
-            width = (interceptOppositeOfLeftCorner.x + interceptOppositeOfTopCorner.x) / 2.0 - x;
-        }
-
-        if(interceptOppositeOfLeftCorner.y < interceptOppositeOfRightCorner.y)
-        {
-            y = (interceptOppositeOfBottomCorner.y + interceptOppositeOfLeftCorner.y) / 2.0;
-            height = (interceptOppositeOfTopCorner.y + interceptOppositeOfRightCorner.y) / 2.0 - y;
-        }
-        else
-        {
-            y = (interceptOppositeOfBottomCorner.y + interceptOppositeOfRightCorner.y) / 2.0;
-            height = (interceptOppositeOfTopCorner.y + interceptOppositeOfLeftCorner.y) / 2.0 - y;
-        }
-
-
-        //draw/crop this rectangle (good place to visualize rect region if debugging)
-        cv::Rect cropRegion(x, y, width, height);
-
-
-        //cv::rectangle(previewImplicitOclImage_m, cropRegion, cv::Scalar( 255, 0, 0 ), 3);
-        cv::UMat(previewImplicitOclImage_m, cropRegion).copyTo(previewImplicitOclImage_m);
+    } catch (cv::Exception e) {
+        emit handleExceptionMessage(QString::fromStdString(e.msg));
     }
 
-    //after computation is complete, push image
-    previewImplicitOclImage_m.copyTo(*previewImage_m);
-    //qDebug() << &previewImplicitOclImage_m << previewImage_m;
-    if(mutex_m) mutex_m->unlock();
     emit updateStatus("");
+    return rendered;
 }
 
 //sets the autoCropForRotate member used in the doRotateComputation function to enable or disable the auto crop attempt.
@@ -315,7 +180,7 @@ void TransformWorker::setAutoCropForRotate(bool value)
  * works see signalsuppressor.h/cpp. The format is tied to the associated menu object. */
 void TransformWorker::receiveScaleSuppressedSignal(SignalSuppressor *dataContainer)
 {
-    doScaleComputation(dataContainer->getNewData().toRect());
+    doScaleComputation(static_cast<ParameterSuppressor<QRect>*>(dataContainer)->getNewData());
     emit updateDisplayedImage();
 }
 
@@ -323,21 +188,25 @@ void TransformWorker::receiveScaleSuppressedSignal(SignalSuppressor *dataContain
 void TransformWorker::doScaleComputation(QRect newSize)
 {
     emit updateStatus("Working...");
-    if(mutex_m) mutex_m->lock();
-    if(masterImage_m == nullptr || previewImage_m == nullptr)
+    //use the latest image published by the GUI, or the last one acquired if it has not changed
+    if(sourceFrames_m) sourceFrames_m->acquire();
+    if(sourceFrames_m == nullptr || previewFrames_m == nullptr || sourceFrames_m->readBuffer().empty())
     {
-        if(mutex_m) mutex_m->unlock();
         qDebug() << "Cannot perform Rotate, image not attached";
         return;
     }
 
     //catch exeception and display so doesnt crash
     try {
-        cv::resize(*masterImage_m, *previewImage_m, cv::Size(newSize.width() - 1, newSize.height() - 1), 0, 0, cv::INTER_LINEAR);
+        cv::Size size(newSize.width() - 1, newSize.height() - 1);
+        processor_m.scale(sourceFrames_m->readBuffer(), previewFrames_m->writeBuffer(), size);
+        EditOperation operation{};
+        operation.type = EditOperation::Scale;
+        operation.region = cv::Rect(cv::Point(0, 0), size);
+        previewFrames_m->publish(operation);
     } catch (cv::Exception e) {
         emit handleExceptionMessage(QString::fromStdString(e.msg));
     }
 
-    if(mutex_m) mutex_m->unlock();
     emit updateStatus("");
 }
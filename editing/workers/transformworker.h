@@ -33,10 +33,11 @@
 *
 * NOTES :
 *       This worker thread uses OpenCV OpenCL accelerated function calls implicitly
-*       when OpenCL hardware is available through OpenCV's UMat object calls. In the
-*       constructor there is an OpenCL initialization step where the OpenCL commands
-*       are given before the functionality is actually used through calling the
-*       appropriate method prematurely. See Issue #41 for more detail.
+*       when OpenCL hardware is available through OpenCV's UMat object calls. The
+*       OpenCL warm-up runs in initialize once the worker is on its own thread,
+*       through OpenClWarmUp::run, which builds the OpenCL programs of the Transform
+*       processor once per process by running it on a small image. The worker
+*       emits ready when it is done. See Issue #41 for more detail.
 *
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
@@ -45,6 +46,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           03/04/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Core Library, Triple Buffers
 *
 ************************************************************************/
 #ifndef TRANSFORMWORKER_H
@@ -53,7 +55,8 @@
 #include <QObject>
 #include <QRect>
 #include <opencv2/core.hpp>
-class QMutex;
+#include "../../core/transformprocessor.h"
+class TripleBuffer;
 class QString;
 class SignalSuppressor;
 
@@ -61,30 +64,29 @@ class TransformWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit TransformWorker(const cv::Mat *masterImage = nullptr, cv::Mat *previewImage = nullptr, QMutex *mutex = nullptr, QObject *parent = nullptr);
+    explicit TransformWorker(TripleBuffer *sourceFrames = nullptr, TripleBuffer *previewFrames = nullptr, QObject *parent = nullptr);
     ~TransformWorker();
 
 signals:
     void updateDisplayedImage();
     void updateStatus(QString);
+    void ready();
     void handleExceptionMessage(QString);
 
 public slots:
+    void initialize();
     void receiveRotateSuppressedSignal(SignalSuppressor *dataContainer);
     void receiveScaleSuppressedSignal(SignalSuppressor *dataContainer);
-    void receiveImageAddresses(const cv::Mat *masterImage, cv::Mat *previewImage);
     void doCropComputation(QRect);
     void setAutoCropForRotate(bool);
-    void doRotateComputation(int);
+    bool doRotateComputation(int);
     void doScaleComputation(QRect);
 
 private:
-    QMutex *mutex_m;
     bool autoCropforRotate_m;
-    const cv::Mat *masterImage_m;
-    cv::Mat *previewImage_m;
-    cv::UMat implicitOclImage_m;
-    cv::UMat previewImplicitOclImage_m;
+    TripleBuffer *sourceFrames_m;
+    TripleBuffer *previewFrames_m;
+    TransformProcessor processor_m;
 
 };
 
@@ -40,12 +40,15 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           10/20/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Rotation Preview
 *
 ************************************************************************/
 #include "imagelabel.h"
 #include <QMouseEvent>
 #include <QPainter>
 #include <QDebug>
+#include <algorithm>
+#include "core/transformprocessor.h"
 
 //constructor
 ImageLabel::ImageLabel(QWidget *parent) : QLabel(parent)
@@ -203,50 +206,98 @@ void ImageLabel::mouseMoveEvent(QMouseEvent *event)
 /* Override of paintEvent that paints 4 trapazoids around a ROI (imageRegion_m), if image is attached,
  * selected by the user through mouse events. Trapazoids are painted to darken the regions outside of the
  * selection as using QRegion would require listing an additional license if distrobuting on a linux machine.
- * ImageLabel_m is signaled to redraw after every paint occurs. */
+ * ImageLabel_m is signaled to redraw after every paint occurs. If a rotation is being previewed the pixmap
+ * is drawn rotated instead.*/
 void ImageLabel::paintEvent(QPaintEvent *event)
 {
+    if(previewDegree_m != 0 && this->pixmap() != nullptr)
+    {
+        QFrame::paintEvent(event);
+        QPainter painter(this);
+        paintPreviewRotation(painter);
+        return;
+    }
+
     QLabel::paintEvent(event);
 
     if(startPainting && this->pixmap() != nullptr && retrieveCoordinateMode_m != NoClick)
     {
-        QRect region = getAdjustedWidgetRegion();
         QPainter painter(this);
-        painter.setBrush(QColor(50, 50, 50));
-        painter.setPen(QColor(50, 50, 50));
-        painter.setCompositionMode(QPainter::CompositionMode_Darken);
-
-        //draw region - 4 trapazoids //print out
-
-        //top
-        QPoint polygon[4] = {
-            this->rect().topLeft(),
-            region.topLeft(),
-            region.topRight(),
-            this->rect().topRight()
-        };
-        painter.drawPolygon(polygon, 4);
-
-        //bottom
-        polygon[0] = this->rect().bottomLeft();
-        polygon[1] = region.bottomLeft();
-        polygon[2] = region.bottomRight();
-        polygon[3] = this->rect().bottomRight();
-        painter.drawPolygon(polygon, 4);
-
-        //left
-        polygon[0] = this->rect().topLeft();
-        polygon[1] = region.topLeft();
-        polygon[2] = region.bottomLeft();
-        polygon[3] = this->rect().bottomLeft();
-        painter.drawPolygon(polygon, 4);
-
-        //right
-        polygon[0] = this->rect().topRight();
-        polygon[1] = region.topRight();
-        polygon[2] = region.bottomRight();
-        polygon[3] = this->rect().bottomRight();
-        painter.drawPolygon(polygon, 4);
+        paintOutsideRegion(painter, getAdjustedWidgetRegion());
+    }
+}
+
+// Darkens the widget outside of region (in widget coordinates) by painting 4 trapazoids around it
+void ImageLabel::paintOutsideRegion(QPainter &painter, const QRect &region)
+{
+    painter.setBrush(QColor(50, 50, 50));
+    painter.setPen(QColor(50, 50, 50));
+    painter.setCompositionMode(QPainter::CompositionMode_Darken);
+
+    //draw region - 4 trapazoids //print out
+
+    //top
+    QPoint polygon[4] = {
+        this->rect().topLeft(),
+        region.topLeft(),
+        region.topRight(),
+        this->rect().topRight()
+    };
+    painter.drawPolygon(polygon, 4);
+
+    //bottom
+    polygon[0] = this->rect().bottomLeft();
+    polygon[1] = region.bottomLeft();
+    polygon[2] = region.bottomRight();
+    polygon[3] = this->rect().bottomRight();
+    painter.drawPolygon(polygon, 4);
+
+    //left
+    polygon[0] = this->rect().topLeft();
+    polygon[1] = region.topLeft();
+    polygon[2] = region.bottomLeft();
+    polygon[3] = this->rect().bottomLeft();
+    painter.drawPolygon(polygon, 4);
+
+    //right
+    polygon[0] = this->rect().topRight();
+    polygon[1] = region.topRight();
+    polygon[2] = region.bottomRight();
+    polygon[3] = this->rect().bottomRight();
+    painter.drawPolygon(polygon, 4);
+}
+
+/* Draws the pixmap rotated by previewDegree_m about the center of the widget, scaled so that the bounding
+ * rectangle of the rotated image fits the widget the way the rotated image will once it is computed. The
+ * region the auto crop keeps is computed by the same TransformProcessor functions the worker uses, and the
+ * rest of the widget is darkened if auto crop is enabled.*/
+void ImageLabel::paintPreviewRotation(QPainter &painter)
+{
+    cv::Size displaySize(this->width(), this->height());
+    cv::Size rotatedSize;
+    TransformProcessor::rotationMatrix(displaySize, previewDegree_m, rotatedSize);
+    if(rotatedSize.width <= 0 || rotatedSize.height <= 0)
+        return;
+
+    double scale = std::min(displaySize.width / static_cast<double>(rotatedSize.width),
+                            displaySize.height / static_cast<double>(rotatedSize.height));
+
+    //positive degrees rotate clockwise in the TransformProcessor, as they do for QPainter
+    painter.save();
+    painter.translate(displaySize.width / 2.0, displaySize.height / 2.0);
+    painter.scale(scale, scale);
+    painter.rotate(previewDegree_m);
+    painter.drawPixmap(QRectF(-displaySize.width / 2.0, -displaySize.height / 2.0, displaySize.width, displaySize.height),
+                       *this->pixmap(), QRectF(this->pixmap()->rect()));
+    painter.restore();
+
+    if(previewAutoCrop_m)
+    {
+        cv::Rect crop = TransformProcessor::autoCropRegion(displaySize, previewDegree_m);
+        QPointF offset((displaySize.width - rotatedSize.width * scale) / 2.0,
+                       (displaySize.height - rotatedSize.height * scale) / 2.0);
+        QRectF region(offset.x() + crop.x * scale, offset.y() + crop.y * scale, crop.width * scale, crop.height * scale);
+        paintOutsideRegion(painter, region.toRect());
     }
 }
 
@@ -361,3 +412,19 @@ void ImageLabel::initializePaintMembers()
     widgetRegion_m = QRect(widgetDragStart_m, widgetDragStart_m);
     brushRadius_m = 0;
 }
+
+/* A slot that previews the image rotated by degree (and the auto crop region if autoCrop is true) by
+ * drawing the current pixmap rotated. A degree of 0 returns to drawing the pixmap as it is.*/
+void ImageLabel::setPreviewRotation(int degree, bool autoCrop)
+{
+    previewDegree_m = degree;
+    previewAutoCrop_m = autoCrop;
+    this->update();
+}
+
+// A slot that stops previewing a rotation, called once the rotated image replaces the pixmap
+void ImageLabel::clearPreviewRotation()
+{
+    if(previewDegree_m != 0)
+        setPreviewRotation(0, false);
+}
@@ -32,7 +32,10 @@
 *       visualizations necessary to use the TransformMenu object effectively.
 *
 * NOTES :
-*
+*       While the rotate slider is dragged the label draws its pixmap
+*       through a QTransform (and the auto crop region) instead of waiting
+*       for the TransformWorker, which only rotates the image once the
+*       slider is released.
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    March 03/04/2019
 *
@@ -40,12 +43,14 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           10/20/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Rotation Preview
 *
 ************************************************************************/
 #ifndef IMAGELABEL_H
 #define IMAGELABEL_H
 
 #include <QLabel>
+class QPainter;
 
 class ImageLabel : public QLabel
 {
@@ -74,6 +79,8 @@ public slots:
     void initializePaintMembers();
     void setRetrieveCoordinateMode(uint mode);
     void setRectRegionSelected(QRect roi);
+    void setPreviewRotation(int degree, bool autoCrop);
+    void clearPreviewRotation();
 
 protected:
     virtual void mouseReleaseEvent(QMouseEvent *event) override;
@@ -85,6 +92,8 @@ private:
     QPoint getPointInImage(QMouseEvent *event);
     QRect getAdjustedImageRegion();
     QRect getAdjustedWidgetRegion();
+    void paintOutsideRegion(QPainter &painter, const QRect &region);
+    void paintPreviewRotation(QPainter &painter);
     void leftMousePressEvent(QMouseEvent *event);
     void leftMouseMoveEvent(QMouseEvent *event);
     void leftMouseReleaseEvent(QMouseEvent *event);
@@ -97,6 +106,8 @@ private:
     float scaleWidth_m = 0;
     float scaleHeight_m = 0;
     uint retrieveCoordinateMode_m = NoClick;
+    int previewDegree_m = 0;
+    bool previewAutoCrop_m = false;
     bool startPainting;
 };
 
@@ -48,6 +48,7 @@
 * 0.4           12/17/2018      Matthew R. Miller       ROI Selection Added
 * 0.5           10/21/2019      Matthew R. Miller       ROI Selection Moved Outside
 * 0.6           12/09/2019      Matthew R. Miller       Point of Interest Zoom
+* 0.7           10/16/2026      agent                   Stage Timing, Scale Signal
 ************************************************************************/
 
 #include "imagewidget.h"
@@ -60,13 +61,13 @@
 #include "imagelabel.h"
 #include <QScrollArea>
 #include <QMenu>
-#include <QMutex>
 #include <QUrl>
 #include <QMimeData>
 #include <QScrollBar>
 #include <QPixmap>
 #include <algorithm>
 #include "app_filters/mousewheelctrleatereventfilter.h"
+#include "core/stageprofiler.h"
 
 #include <QDebug>
 
@@ -156,18 +157,13 @@ void ImageWidget::setImage(const QImage *image)
         return;
     }
 
-    //while waiting for mutex, process main event loop to keep gui responsive
-    if(mutex_m)
-    {
-        while(!mutex_m->tryLock())
-            QApplication::processEvents(QEventLoop::AllEvents, 100);
-    }
-
+    StageTimer stage("setImage");
     attachedImage_m = image;
     imageLabel_m->setPixmap(QPixmap::fromImage(*image));
-    if(mutex_m) mutex_m->unlock();
+    stage.lap("QPixmap::fromImage");
     //qDebug() << *imageLabel_m->pixmap() << image->bytesPerLine();
     zoomFit();
+    stage.lap("zoomFit");
     imageLabel_m->setVisible(true);
     emit imageSet();
 }
@@ -211,13 +207,6 @@ const QImage *ImageWidget::displayedImage()
     return attachedImage_m;
 }
 
-/*Sets and enables a mutex lock for updating the image from a QImage buffer.
- * Set to nullptr to disable*/
-void ImageWidget::setMutex(QMutex &m)
-{
-    mutex_m = &m;
-}
-
 /* Member function clearImage clears the attached image pointer and hides the imageLabel_m containing
  * the QPixmap displaying the previously attached image. ImageWidget does not maintain the object
  * for the attached QImage data buffer and must be distroyed separately.*/
@@ -246,6 +235,7 @@ void ImageWidget::zoomIn(QPoint pointOfInterest)
     scalar_m *= ZOOM_IN_SCALAR;
     imageLabel_m->resize(scalar_m * attachedImage_m->size());
     adjustScrollBar(pointOfInterest, ZOOM_IN_SCALAR);
+    emit scaleChanged(scalar_m);
 
     if (fillScrollArea_m == true)
     {
@@ -270,6 +260,7 @@ void ImageWidget::zoomOut(QPoint pointOfInterest)
     scalar_m *= ZOOM_OUT_SCALAR;
     imageLabel_m->resize(scalar_m * attachedImage_m->size());
     adjustScrollBar(pointOfInterest, ZOOM_OUT_SCALAR);
+    emit scaleChanged(scalar_m);
 
     if (fillScrollArea_m == true)
     {
@@ -280,7 +271,8 @@ void ImageWidget::zoomOut(QPoint pointOfInterest)
 
 /* The zoomFit member function scales the image to fit full size within the ImageWidget while
  * maintaining its aspect ratio. It does so by scaling by the smaller aspect ratio relation
- * between width and height. If the fill property is false, its set to true and emits a signal*/
+ * between width and height. If the fill property is false, its set to true and emits a signal.
+ * As it is also called when the widget is resized, the new scale is always emitted.*/
 void ImageWidget::zoomFit()
 {
     if(!imageAttached()) return;
@@ -298,6 +290,7 @@ void ImageWidget::zoomFit()
         fillScrollArea_m = true;
         emit fillWidgetChanged(true);
     }
+    emit scaleChanged(scalar_m);
 }
 
 /* The zoomActual member function scales the image to the actual dimension of the attached
@@ -308,6 +301,7 @@ void ImageWidget::zoomActual()
     if(!imageAttached()) return;
     imageLabel_m->adjustSize();
     scalar_m = 1.0;
+    emit scaleChanged(scalar_m);
     if (fillScrollArea_m == true)
     {
         fillScrollArea_m = false;
@@ -329,20 +323,13 @@ void ImageWidget::zoomAgain()
 
 
 /* When called, the Pixmap is refreshed (reloaded) with the attached QImage but not resized.
- * Because of the possibility this function will operate on an image outside of the class,
- * a mutex locks the operation if it is available*/
+ * The attached QImage must only be changed by the GUI thread; images rendered by other threads
+ * are handed to the GUI thread before they are attached (see TripleBuffer).*/
 void ImageWidget::updateDisplayedImage()
 {
     if(!imageAttached()) return;
 
-    //while waiting for mutex, process main event loop to keep gui responsive
-    if(mutex_m)
-    {
-        while(!mutex_m->tryLock())
-            QApplication::processEvents(QEventLoop::AllEvents, 100);
-    }
     imageLabel_m->setPixmap(QPixmap::fromImage(*attachedImage_m));
-    if(mutex_m) mutex_m->unlock();
     //qDebug() << *imageLabel_m->pixmap();
 }
 
@@ -47,6 +47,7 @@
 * 0.2           06/23/2018      Matthew R. Miller       Drag and Drop Open
 * 0.3           10/26/2018      Matthew R. Miller       Pixel Selection Added
 * 0.4           12/17/2018      Matthew R. Miller       ROI Selection Added
+* 0.5           10/16/2026      agent                   Stage Timing, Scale Signal
 ************************************************************************/
 
 #ifndef IMAGEWIDGET_H
@@ -58,7 +59,6 @@ class ImageLabel;
 class QScrollArea;
 class QImage;
 class QMenu;
-class QMutex;
 class QPixmap;
 class MouseWheelCtrlEaterEventFilter;
 
@@ -79,13 +79,13 @@ public:
     bool fillWidgetStatus() const;
     const QImage* displayedImage();
     ImageLabel *imageLabel_m;
-    void setMutex(QMutex &m);
 
 signals:
     void imageSet();
     void imageCleared();
     void imageNull();
     void fillWidgetChanged(bool fillScrollArea);
+    void scaleChanged(float scale);
     void droppedImagePath(QString imagePath);
     void droppedImageError();
 
@@ -105,7 +105,6 @@ protected:
     virtual void dragEnterEvent(QDragEnterEvent *event) override;
     virtual void dragLeaveEvent(QDragLeaveEvent *event) override;
     virtual void dropEvent(QDropEvent *event) override;
-    QMutex *mutex_m = nullptr;
 
 private:
     void zoomAgain();
@@ -32,7 +32,10 @@
 *       the GUI interface and launches the QApplication.
 *
 * NOTES :
-*       None.
+*       If the --batch flag is passed the GUI is not created. Instead the
+*       application runs headless through the BatchProcessor.
+*       If the QCVTOUCHUP_TRACE environment variable is set, the stage
+*       timings are written to that file as a Chrome trace on exit.
 *
 * AUTHOR :  Matthew R. Miller       START DATE :    November 11, 2017
 *
@@ -40,16 +43,30 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           11/11/2017      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Batch Mode, Stage Trace
 *
 ************************************************************************/
 
 #include "mainwindow.h"
 #include "app_filters/signalsuppressor.h"
+#include "batch/batchprocessor.h"
+#include "core/stageprofiler.h"
 #include <QApplication>
+#include <QCoreApplication>
 #include <QMetaType>
 
 int main(int argc, char *argv[])
 {
+    //headless batch mode, no display is required
+    if(BatchProcessor::isBatchRequested(argc, argv))
+    {
+        QCoreApplication batchApplication(argc, argv);
+        BatchProcessor processor;
+        int result = processor.exec(batchApplication);
+        StageProfiler::instance().writeTrace();
+        return result;
+    }
+
     QApplication a(argc, argv);
 
     //load stylesheet
@@ -63,10 +80,11 @@ int main(int argc, char *argv[])
     qRegisterMetaType<QVector<float>>("QVector<float>");
     qRegisterMetaType<QVector<int>>("QVector<int>");
     qRegisterMetaType<SignalSuppressor*>("SignalSuppressor*");
-    qRegisterMetaType<cv::Mat*>("cv::Mat*");
 
     MainWindow w;
     w.show();
 
-    return a.exec();
+    int result = a.exec();
+    StageProfiler::instance().writeTrace();
+    return result;
 }
@@ -38,6 +38,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           11/03/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Edit Graph, Proxy, Tiles, Undo
 *
 ************************************************************************/
 
@@ -53,6 +54,8 @@
 #include "imagewidget.h"
 #include "dialog/imagesavedialog.h"
 #include "imagelabel.h"
+#include "core/stageprofiler.h"
+#include "core/openclwarmup.h"
 #include <QWidget>
 #include <QApplication>
 #include <QFileDialog>
@@ -62,31 +65,56 @@
 #include <QDir>
 #include <QString>
 #include <QImage>
+#include <QLabel>
+#include <QStringList>
+#include <QTimer>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/core/ocl.hpp>
 #include <QHBoxLayout>
+#include <algorithm>
+#include <cmath>
+
+//images above this many pixels are kept in tiles and edited through a working copy of this many pixels
+#define TILED_IMAGE_THRESHOLD 100000000
+#define TILED_WORKING_PIXELS 24000000
+//the proxy is rebuilt once the zoom or window size has not changed for this many milliseconds
+#define PROXY_REFRESH_DELAY_MS 200
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     ui(new Ui::MainWindow)
 {
-    //main operation setup, members, and mutex
+    startupTime_m = StageProfiler::Clock::now();
+
+    //main operation setup and members
     ui->setupUi(this);
     setWindowTitle("qcvTouchUp");
     userImagePath_m = QDir::homePath();
-    ui->imageWidget->setMutex(mutex_m);
 
     masterRGBImage_m = cv::Mat(0, 0, CV_8UC3);
     previewRGBImage_m = cv::Mat(0, 0, CV_8UC3);
+    editedRGBImage_m = cv::Mat(0, 0, CV_8UC3);
+    previewIsProxy_m = false;
+    trackingSetUp_m = false;
+
+    //time spent in each stage of the last preview, shown next to the status messages
+    stageTimingLabel_m = new QLabel(this);
+    statusBar()->addPermanentWidget(stageTimingLabel_m);
+
+    //zooming and resizing change the scale the proxy is displayed at, but only the last change is acted on
+    proxyTimer_m = new QTimer(this);
+    proxyTimer_m->setSingleShot(true);
+    proxyTimer_m->setInterval(PROXY_REFRESH_DELAY_MS);
+    connect(proxyTimer_m, SIGNAL(timeout()), this, SLOT(refreshProxyImage()));
 
     //image menus initializations - signals are connected after to not be emitted during initialization
-    adjustMenu_m = new AdjustMenu(&mutex_m, this);
+    adjustMenu_m = new AdjustMenu(this);
     ui->toolMenu->addWidget(adjustMenu_m);
-    filterMenu_m = new FilterMenu(&mutex_m, this);
+    filterMenu_m = new FilterMenu(this);
     ui->toolMenu->addWidget(filterMenu_m);
-    temperatureMenu_m = new TemperatureMenu(&mutex_m, this);
+    temperatureMenu_m = new TemperatureMenu(this);
     ui->toolMenu->addWidget(temperatureMenu_m);
-    transformMenu_m = new TransformMenu(&mutex_m, this);
+    transformMenu_m = new TransformMenu(this);
     ui->toolMenu->addWidget(transformMenu_m);
     //colorSliceMenu_m = new ColorSliceMenu(this);
     //ui->toolMenu->addWidget(colorSliceMenu_m);
@@ -106,6 +134,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     connect(ui->toolMenu, SIGNAL(currentChanged(int)), this, SLOT(cancelPreview()));
     connect(ui->pushButtonCancel, SIGNAL(released()), this, SLOT(cancelPreview()));
     connect(ui->pushButtonApply, SIGNAL(released()), this, SLOT(applyPreviewToMaster()));
+    connect(ui->actionUndo, SIGNAL(triggered()), this, SLOT(undoEdit()));
+    connect(ui->actionRedo, SIGNAL(triggered()), this, SLOT(redoEdit()));
     connect(ui->actionAdjust, &QAction::triggered, [=](){ui->toolMenu->setCurrentIndex(0);}); //lambda
     connect(ui->actionFilter, &QAction::triggered, [=](){ui->toolMenu->setCurrentIndex(1);}); //lambda
     connect(ui->actionTemperature, &QAction::triggered, [=](){ui->toolMenu->setCurrentIndex(2);}); //lambda
@@ -115,54 +145,114 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     connect(ui->imageWidget, SIGNAL(imageNull()), this, SLOT(imageOpenOperationFailed()));
     connect(ui->imageWidget, SIGNAL(droppedImagePath(QString)), this, SLOT(loadImageIntoMemory(QString)));
     connect(ui->imageWidget, SIGNAL(droppedImageError()), this, SLOT(imageOpenOperationFailed()));
+    connect(ui->imageWidget, SIGNAL(scaleChanged(float)), proxyTimer_m, SLOT(start()));
 
     //connect necessary adjustmenu / ui slots
     connect(ui->pushButtonCancel, SIGNAL(released()), adjustMenu_m, SLOT(initializeSliders()));
     connect(ui->pushButtonApply, SIGNAL(released()), adjustMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionUndo, SIGNAL(triggered()), adjustMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionRedo, SIGNAL(triggered()), adjustMenu_m, SLOT(initializeSliders()));
     connect(adjustMenu_m, SIGNAL(updateDisplayedImage()), this, SLOT(displayPreview()));
     connect(adjustMenu_m, SIGNAL(updateStatus(QString)), ui->statusBar, SLOT(showMessage(QString)));
     connect(this, SIGNAL(setDefaultTracking(bool)), adjustMenu_m, SLOT(setMenuTracking(bool)));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), adjustMenu_m, SLOT(initializeSliders()));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), adjustMenu_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
+    connect(this, SIGNAL(imageChanged()), adjustMenu_m, SLOT(initializeSliders()));
+    connect(this, SIGNAL(distributeProxyBuffer(const cv::Mat&)), adjustMenu_m, SLOT(receiveSourceImage(const cv::Mat&)));
 
     //connect necessary filtermenu / ui slots
     connect(ui->pushButtonCancel, SIGNAL(released()), filterMenu_m, SLOT(initializeSliders()));
     connect(ui->pushButtonApply, SIGNAL(released()), filterMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionUndo, SIGNAL(triggered()), filterMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionRedo, SIGNAL(triggered()), filterMenu_m, SLOT(initializeSliders()));
     connect(filterMenu_m, SIGNAL(updateDisplayedImage()), this, SLOT(displayPreview()));
     connect(filterMenu_m, SIGNAL(updateStatus(QString)), ui->statusBar, SLOT(showMessage(QString)));
     connect(this, SIGNAL(setDefaultTracking(bool)), filterMenu_m, SLOT(setMenuTracking(bool)));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), filterMenu_m, SLOT(initializeSliders()));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), filterMenu_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
+    connect(this, SIGNAL(imageChanged()), filterMenu_m, SLOT(initializeSliders()));
+    connect(this, SIGNAL(distributeFullResolutionSize(const cv::Size&)), filterMenu_m, SLOT(receiveFullResolutionSize(const cv::Size&)));
+    connect(this, SIGNAL(distributeProxyBuffer(const cv::Mat&)), filterMenu_m, SLOT(receiveSourceImage(const cv::Mat&)));
 
     //connect necessary temperaturemenu / ui slots
     connect(ui->pushButtonCancel, SIGNAL(released()), temperatureMenu_m, SLOT(initializeSliders()));
     connect(ui->pushButtonApply, SIGNAL(released()), temperatureMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionUndo, SIGNAL(triggered()), temperatureMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionRedo, SIGNAL(triggered()), temperatureMenu_m, SLOT(initializeSliders()));
     connect(temperatureMenu_m, SIGNAL(updateDisplayedImage()), this, SLOT(displayPreview()));
     connect(temperatureMenu_m, SIGNAL(updateStatus(QString)), ui->statusBar, SLOT(showMessage(QString)));
     connect(this, SIGNAL(setDefaultTracking(bool)), temperatureMenu_m, SLOT(setMenuTracking(bool)));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), temperatureMenu_m, SLOT(initializeSliders()));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), temperatureMenu_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
+    connect(this, SIGNAL(imageChanged()), temperatureMenu_m, SLOT(initializeSliders()));
+    connect(this, SIGNAL(distributeProxyBuffer(const cv::Mat&)), temperatureMenu_m, SLOT(receiveSourceImage(const cv::Mat&)));
 
     //connect necessary transformmenu / ui slots
     connect(ui->pushButtonCancel, SIGNAL(released()), transformMenu_m, SLOT(initializeSliders()));
     connect(ui->pushButtonApply, SIGNAL(released()), transformMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionUndo, SIGNAL(triggered()), transformMenu_m, SLOT(initializeSliders()));
+    connect(ui->actionRedo, SIGNAL(triggered()), transformMenu_m, SLOT(initializeSliders()));
     connect(transformMenu_m, SIGNAL(updateDisplayedImage()), this, SLOT(displayPreview()));
     connect(transformMenu_m, SIGNAL(updateStatus(QString)), ui->statusBar, SLOT(showMessage(QString)));
     connect(transformMenu_m, SIGNAL(displayMaster()), this, SLOT(cancelPreview()));
     connect(this, SIGNAL(setDefaultTracking(bool)), transformMenu_m, SLOT(setMenuTracking(bool)));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), transformMenu_m, SLOT(initializeSliders()));
-    connect(this, SIGNAL(distributeImageBufferAddresses(const cv::Mat*, cv::Mat*)), transformMenu_m, SLOT(receiveImageAddresses(const cv::Mat*, cv::Mat*)));
+    connect(this, SIGNAL(imageChanged()), transformMenu_m, SLOT(initializeSliders()));
+    connect(this, SIGNAL(distributeImageBuffer(const cv::Mat&)), transformMenu_m, SLOT(receiveSourceImage(const cv::Mat&)));
     connect(ui->imageWidget->imageLabel_m, SIGNAL(imageRectRegionSelected(QRect)), transformMenu_m, SLOT(setImageROI(QRect)));
     connect(transformMenu_m, SIGNAL(giveImageROI(QRect)), ui->imageWidget->imageLabel_m, SLOT(setRectRegionSelected(QRect)));
     connect(transformMenu_m, SIGNAL(setGetCoordinateMode(uint)), ui->imageWidget->imageLabel_m, SLOT(setRetrieveCoordinateMode(uint)));
+    connect(transformMenu_m, SIGNAL(previewRotation(int,bool)), ui->imageWidget->imageLabel_m, SLOT(setPreviewRotation(int,bool)));
+    connect(transformMenu_m, SIGNAL(updateDisplayedImage()), ui->imageWidget->imageLabel_m, SLOT(clearPreviewRotation()));
+
+    //each menu reports when its worker has warmed up, the warm-up itself starts once the window is shown
+    connect(adjustMenu_m, SIGNAL(workerReady()), this, SLOT(menuWorkerReady()));
+    connect(filterMenu_m, SIGNAL(workerReady()), this, SLOT(menuWorkerReady()));
+    connect(temperatureMenu_m, SIGNAL(workerReady()), this, SLOT(menuWorkerReady()));
+    connect(transformMenu_m, SIGNAL(workerReady()), this, SLOT(menuWorkerReady()));
+    QTimer::singleShot(0, this, SLOT(scheduleWarmUp()));
+}
+
+/* Called from the event loop once the window has been shown. The menu workers are started here instead of
+ * when their menu is first shown so that the OpenCL context and the kernels are built on the worker threads
+ * in the background while the window is already responsive, starting with the menu that is visible. Whether
+ * OpenCL is available is only known once the first worker reports it is ready (see menuWorkerReady).*/
+void MainWindow::scheduleWarmUp()
+{
+    int visibleMenu = ui->toolMenu->currentIndex();
+    switch(visibleMenu)
+    {
+    case 1:
+        filterMenu_m->startWorker();
+        break;
+    case 2:
+        temperatureMenu_m->startWorker();
+        break;
+    case 3:
+        transformMenu_m->startWorker();
+        break;
+    default:
+        adjustMenu_m->startWorker();
+        break;
+    }
+
+    //then the remaining menus, skipping the one already started
+    if(visibleMenu >= 1 && visibleMenu <= 3)
+        adjustMenu_m->startWorker();
+    if(visibleMenu != 1)
+        filterMenu_m->startWorker();
+    if(visibleMenu != 2)
+        temperatureMenu_m->startWorker();
+    if(visibleMenu != 3)
+        transformMenu_m->startWorker();
+}
 
-    //Check if OpenCL acceleration is available. If it is available, enable menu item tracking for all child menues, else disable
-    cv::ocl::Context ctx = cv::ocl::Context::getDefault();
-    if (!ctx.ptr())
+/* Sets up menu item tracking once a worker has detected whether OpenCL is available. If it is available,
+ * tracking is enabled for all child menus, else it is disabled for the menus without a fast path on the CPU.*/
+void MainWindow::setUpTracking(bool openClAvailable)
+{
+    if (!openClAvailable)
     {
         statusBar()->showMessage("OpenCL is not available", 3000);
         ui->actionTracking->setEnabled(false);
         emit setDefaultTracking(false);
+
+        //the adjust and temperature previews are applied through a color cube on the CPU, fast enough to track
+        adjustMenu_m->setMenuTracking(true);
+        temperatureMenu_m->setMenuTracking(true);
     }
     else
     {
@@ -171,6 +261,26 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent),
     }
 }
 
+/* Called each time a menu reports that its worker has warmed up. The first report carries whether the
+ * worker found OpenCL, which sets up menu tracking. Once every menu is ready the time from the creation
+ * of the window is recorded as the startup to interactive time of the application.*/
+void MainWindow::menuWorkerReady()
+{
+    if(!trackingSetUp_m)
+    {
+        trackingSetUp_m = true;
+        setUpTracking(OpenClWarmUp::isAvailable());
+    }
+
+    if(!adjustMenu_m->isWorkerReady() || !filterMenu_m->isWorkerReady()
+            || !temperatureMenu_m->isWorkerReady() || !transformMenu_m->isWorkerReady())
+        return;
+
+    StageProfiler::Clock::time_point now = StageProfiler::Clock::now();
+    StageProfiler::instance().record("startup", "startup to interactive", startupTime_m, now);
+    statusBar()->showMessage("Ready", 3000);
+}
+
 //delete heap data not a child of mainwindow
 MainWindow::~MainWindow()
 {
@@ -183,6 +293,11 @@ void MainWindow::imageOpenOperationFailed()
     ui->imageWidget->clearImage();
     masterRGBImage_m.release();
     previewRGBImage_m.release();
+    editedRGBImage_m.release();
+    masterTiles_m.release();
+    editGraph_m.setSource(cv::Mat());
+    updateProxyImage();
+    clearHistory();
     updateImageInformation(nullptr);
     QMessageBox::warning(this, "Error", "Unable to access desired image.");
 }
@@ -202,7 +317,11 @@ void MainWindow::updateImageInformation(const QImage *image)
     else
     {
         setWindowTitle("qcvTouchUp - " + QFileInfo(userImagePath_m.absolutePath()).fileName());
-        ui->labelSize->setText("Size: " + QString::number(image->width())+"x"+QString::number(image->height()));
+        if(masterTiles_m.empty())
+            ui->labelSize->setText("Size: " + QString::number(image->width())+"x"+QString::number(image->height()));
+        else
+            ui->labelSize->setText("Size: " + QString::number(masterTiles_m.size().width)+"x"
+                                   +QString::number(masterTiles_m.size().height)+" (tiled)");
         ui->labelType->setText("Type: " + qcv::getMatType(qcv::qImageToCvMat(*image)));
         transformMenu_m->setImageResolution(image->rect());
         //colorSliceMenu_m->setImageReference(image);
@@ -239,14 +358,15 @@ void MainWindow::getImagePath()
 bool MainWindow::loadImageIntoMemory(QString imagePath)
 {
     statusBar()->showMessage("Opening...");
-    //while waiting for mutex, process main event loop to keep gui responsive
-    while(!mutex_m.tryLock())
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
 
-    //clear the image buffer and path. Try to open image in BGR format
+    /* clear the image buffer and path. Try to open image in BGR format. The workers keep the images
+     * published to them until the new image is published, so the buffers are released and not reused.*/
     userImagePath_m = QDir::homePath();
     previewRGBImage_m.release();
+    editedRGBImage_m.release();
     masterRGBImage_m.release();
+    masterTiles_m.release();
+    clearHistory();
     masterRGBImage_m = cv::imread(imagePath.toStdString(), cv::IMREAD_COLOR);
     qDebug() << "MainWindow Images:" << &masterRGBImage_m << &previewRGBImage_m;
 
@@ -256,24 +376,39 @@ bool MainWindow::loadImageIntoMemory(QString imagePath)
     {
         imageOpenOperationFailed();
         returnSuccess = false;
-        emit distributeImageBufferAddresses(nullptr, nullptr);
+        emit imageChanged();
     }
     else
     {
         //if successfully loaded, convert to RGB color space and wrap in QImage
         cv::cvtColor(masterRGBImage_m, masterRGBImage_m, cv::COLOR_BGR2RGB);
-        masterRGBImage_m.copyTo(previewRGBImage_m);
+
+        /* very large images are moved into tiles that can be paged to disk and the menus edit a reduced
+         * working copy instead. If the tiles can not be created the whole image is kept in memory.*/
+        if(masterRGBImage_m.total() > TILED_IMAGE_THRESHOLD)
+        {
+            try {
+                masterTiles_m.fromMat(masterRGBImage_m);
+                masterTiles_m.toMat(masterRGBImage_m, tiledWorkingSize());
+            } catch (const cv::Exception &e) {
+                qDebug() << QString::fromStdString(e.msg);
+                masterTiles_m.release();
+            }
+        }
+        editGraph_m.setSource(masterRGBImage_m);
+        previewRGBImage_m = masterRGBImage_m;
+        editedRGBImage_m = masterRGBImage_m;
+        previewOperation_m = EditOperation();
         imageWrapper_m = QImage(qcv::cvMatToQImage(masterRGBImage_m));
     }
+    previewIsProxy_m = false;
 
-    mutex_m.unlock();
-
-    // success ops outside of mutex
     if(returnSuccess)
     {
-        ui->imageWidget->setImage(&imageWrapper_m); //mutex operation
+        ui->imageWidget->setImage(&imageWrapper_m);
         userImagePath_m = imagePath;
-        emit distributeImageBufferAddresses(&masterRGBImage_m, &previewRGBImage_m);
+        updateProxyImage();
+        emit imageChanged();
         updateImageInformation(&imageWrapper_m);
     }
 
@@ -283,63 +418,433 @@ bool MainWindow::loadImageIntoMemory(QString imagePath)
 }
 
 /* This slot cancels the image operations by wrapping the Mat in a Qimage and setting the imagewidget
- * to display the master image buffer.*/
+ * to display the output of every edit. It is also called when the active menu changes, so the master
+ * is first set to the output of the edit graph up to the stage of the active menu.*/
 void MainWindow::cancelPreview()
 {
-    while(!mutex_m.tryLock())
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
-    imageWrapper_m = qcv::cvMatToQImage(masterRGBImage_m);
-    masterRGBImage_m.copyTo(previewRGBImage_m);
-    mutex_m.unlock();
+    cv::Size previousSize(editedRGBImage_m.cols, editedRGBImage_m.rows);
+    loadActiveStageIntoMaster();
+    imageWrapper_m = qcv::cvMatToQImage(editedRGBImage_m);
+    previewRGBImage_m = masterRGBImage_m;
+    previewOperation_m = EditOperation();
+    previewIsProxy_m = false;
+    if(!editedRGBImage_m.empty() && previousSize != cv::Size(editedRGBImage_m.cols, editedRGBImage_m.rows))
+        updateImageInformation(&imageWrapper_m);
     ui->imageWidget->setImage(&imageWrapper_m);
+    updateProxyImage();
+    showStageTimings();
 }
 
-/* This slot applies the previewed operation of the image to the master buffer by performing a deep
- * copy of the preview to the master buffer. Then it wraps the master buffer as a QImage and displays it*/
+/* This slot applies the previewed operation of the image by appending it to the edit graph. If the
+ * preview was rendered at full resolution it becomes the cached output of the operation's stage,
+ * otherwise the operation is rendered again from the cached full resolution input of the stage. If
+ * the master is tiled, the operation is applied to the tiles instead and the new working copy becomes
+ * the source of the edit graph. Then it wraps the master buffer as a QImage and displays it*/
 void MainWindow::applyPreviewToMaster()
 {
-    while(!mutex_m.tryLock())
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
-    masterRGBImage_m.release();
-    previewRGBImage_m.copyTo(masterRGBImage_m);
-    imageWrapper_m = qcv::cvMatToQImage(masterRGBImage_m);
-    mutex_m.unlock();
+    if(!masterTiles_m.empty())
+        applyTiledEdit();
+    else
+        commitActiveEdit();
+    displayEditedMaster();
+}
+
+/* This slot undoes the last applied edit. If the master is tiled, the tiles changed by the edit are
+ * restored from the compressed undo history, else the edit is removed from its stage of the edit graph
+ * and the stage is rendered again from its cached input. The edit can then be redone.*/
+void MainWindow::undoEdit()
+{
+    if(undoOperations_m.isEmpty())
+        return;
+
+    statusBar()->showMessage("Undoing...");
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QString message;
+    try {
+        if(!masterTiles_m.empty())
+        {
+            tileHistory_m.restore(masterTiles_m);
+            cv::Mat workingImage;
+            masterTiles_m.toMat(workingImage, tiledWorkingSize());
+            editGraph_m.setSource(workingImage);
+        }
+        else
+        {
+            EditGraph::Stage stage = EditGraph::stageOf(undoOperations_m.last().type);
+            std::vector<EditOperation> operations = editGraph_m.operations(stage);
+            if(!operations.empty())
+                operations.pop_back();
+            editGraph_m.setOperations(stage, operations);
+        }
+        redoOperations_m.append(undoOperations_m.takeLast());
+    } catch (const cv::Exception &e) {
+        message = QString::fromStdString(e.msg);
+    }
+    QApplication::restoreOverrideCursor();
+    statusBar()->showMessage(message, 5000);
+    displayEditedMaster();
+}
+
+// This slot applies the last undone edit again.
+void MainWindow::redoEdit()
+{
+    if(redoOperations_m.isEmpty())
+        return;
+
+    statusBar()->showMessage("Redoing...");
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QString message;
+    try {
+        if(!masterTiles_m.empty())
+            applyTiledOperation(redoOperations_m.last());
+        else
+            editGraph_m.appendOperation(redoOperations_m.last());
+        undoOperations_m.append(redoOperations_m.takeLast());
+    } catch (const cv::Exception &e) {
+        message = QString::fromStdString(e.msg);
+    }
+    QApplication::restoreOverrideCursor();
+    statusBar()->showMessage(message, 5000);
+    displayEditedMaster();
+}
+
+/* Displays the image after the edits were changed by Apply, Undo, or Redo. The master is loaded from
+ * the edit graph and the output of every stage is shown.*/
+void MainWindow::displayEditedMaster()
+{
+    loadActiveStageIntoMaster();
+    previewRGBImage_m = masterRGBImage_m;
+    previewOperation_m = EditOperation();
+    imageWrapper_m = qcv::cvMatToQImage(editedRGBImage_m);
+    previewIsProxy_m = false;
     updateImageInformation(&imageWrapper_m);
     ui->imageWidget->setImage(&imageWrapper_m);
+    updateProxyImage();
+    showStageTimings();
+    updateHistoryActions();
+}
+
+// Enables the Undo and Redo actions only when there is an edit to undo or redo
+void MainWindow::updateHistoryActions()
+{
+    ui->actionUndo->setEnabled(!undoOperations_m.isEmpty());
+    ui->actionRedo->setEnabled(!redoOperations_m.isEmpty());
+}
+
+// Removes every edit from the undo and redo history, such as when a new image is opened
+void MainWindow::clearHistory()
+{
+    undoOperations_m.clear();
+    redoOperations_m.clear();
+    tileHistory_m.clear();
+    updateHistoryActions();
 }
 
-// This slot wraps the preview image buffer in a QImage and displays it via the imageWidget
+/* This slot acquires the latest preview published by the worker of the active menu, wraps it in a
+ * QImage and displays it via the imageWidget. Previews replaced by a newer one before the GUI got to
+ * them are skipped, and if there is no new preview (e.g. it was already displayed) nothing is done.*/
 void MainWindow::displayPreview()
 {
-    while(!mutex_m.tryLock())
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
+    TripleBuffer *frames = activePreviewFrames();
+    if(frames == nullptr || !frames->acquire())
+        return;
+
+    StageTimer stage("displayPreview");
+    previewRGBImage_m = frames->readBuffer();
+    previewOperation_m = frames->readOperation();
     imageWrapper_m = qcv::cvMatToQImage(previewRGBImage_m);
-    mutex_m.unlock();
+    previewIsProxy_m = ui->toolMenu->currentIndex() <= 2 && proxyRGBImage_m.data != masterRGBImage_m.data;
+    stage.lap("wrap preview");
     ui->imageWidget->setImage(&imageWrapper_m);
+    showStageTimings();
+}
+
+/* Rebuilds the proxy image the Adjust, Filter, and Temperature menus preview from. The proxy is the
+ * master image scaled to the size it is displayed at in the ImageWidget (its scale relative to the
+ * master, not to the image currently shown) so that slider previews only process the pixels that
+ * can be seen. If the master is displayed at or above its actual size, the proxy shares the master's
+ * buffer and no scaling is done. The master and proxy are then published to the menus' workers, along
+ * with the full resolution size the proxy stands in for.*/
+void MainWindow::updateProxyImage()
+{
+    cv::Size proxySize = proxyImageSize();
+    if(proxySize == masterRGBImage_m.size())
+        proxyRGBImage_m = masterRGBImage_m;
+    else
+    {
+        //a worker may still be rendering from the last proxy published, so it is not resized in place
+        proxyRGBImage_m.release();
+        cv::resize(masterRGBImage_m, proxyRGBImage_m, proxySize, 0, 0, cv::INTER_AREA);
+    }
+
+    emit distributeImageBuffer(masterRGBImage_m);
+    emit distributeFullResolutionSize(masterTiles_m.empty() ? masterRGBImage_m.size() : masterTiles_m.size());
+    emit distributeProxyBuffer(proxyRGBImage_m);
+}
+
+/* Returns the size of the master scaled to the size it is displayed at in the ImageWidget, or the size
+ * of the master if it is displayed at or above its actual size. Only a proxy preview is displayed at a
+ * different resolution than the master, any other image is shown at the scale the master would be.*/
+cv::Size MainWindow::proxyImageSize() const
+{
+    const QImage *displayed = ui->imageWidget->displayedImage();
+    float scale = ui->imageWidget->currentScale();
+    if(previewIsProxy_m && displayed && displayed->width() > 0 && masterRGBImage_m.cols > 0)
+        scale *= displayed->width() / static_cast<float>(masterRGBImage_m.cols);
+
+    cv::Size proxySize(qRound(masterRGBImage_m.cols * scale), qRound(masterRGBImage_m.rows * scale));
+    if(scale >= 1.0f || proxySize.width < 1 || proxySize.height < 1)
+        return masterRGBImage_m.size();
+    return proxySize;
+}
+
+/* Called once the zoom or the size of the ImageWidget has settled. The proxy is only rebuilt if the master
+ * or a preview made from the proxy is displayed, as the scale can not be related to the master for the
+ * other previews, and only if the size the master is displayed at has changed.*/
+void MainWindow::refreshProxyImage()
+{
+    if(masterRGBImage_m.empty() || (!previewIsProxy_m && previewRGBImage_m.data != masterRGBImage_m.data))
+        return;
+    if(proxyImageSize() != proxyRGBImage_m.size())
+        updateProxyImage();
 }
 
-/* saveImageAs first acquires the mutex, then converts the image from the RGB format used to display
+/* Returns the stage of the edit graph the active menu edits. The menus are ordered Adjust, Filter,
+ * Temperature, Transform in the tool menu while the stages are applied Adjust, Temperature, Filter,
+ * Transform.*/
+EditGraph::Stage MainWindow::activeStage() const
+{
+    switch (ui->toolMenu->currentIndex())
+    {
+    case 0:
+        return EditGraph::AdjustStage;
+    case 1:
+        return EditGraph::FilterStage;
+    case 2:
+        return EditGraph::TemperatureStage;
+    default:
+        return EditGraph::TransformStage;
+    }
+}
+
+// Returns the frames the worker of the active menu publishes its previews to
+TripleBuffer *MainWindow::activePreviewFrames() const
+{
+    switch (ui->toolMenu->currentIndex())
+    {
+    case 0:
+        return adjustMenu_m->previewFrames();
+    case 1:
+        return filterMenu_m->previewFrames();
+    case 2:
+        return temperatureMenu_m->previewFrames();
+    case 3:
+        return transformMenu_m->previewFrames();
+    default:
+        return nullptr;
+    }
+}
+
+// Returns the operation currently selected in the active menu. The type is None if there is none.
+EditOperation MainWindow::activeMenuOperation() const
+{
+    switch (ui->toolMenu->currentIndex())
+    {
+    case 0:
+        return adjustMenu_m->editOperation();
+    case 1:
+        return filterMenu_m->editOperation();
+    case 2:
+        return temperatureMenu_m->editOperation();
+    case 3:
+        return transformMenu_m->editOperation();
+    default:
+        return EditOperation{};
+    }
+}
+
+/* Returns true if applying operation would change the image as the user expects. That is the case once a
+ * preview has been rendered by the active menu, or if the operation differs from the one the menu resets to
+ * (the Filter and Transform menus reset to no operation). Applying an untouched menu is a no-op.*/
+bool MainWindow::hasPendingEdit(const EditOperation &operation) const
+{
+    if(previewIsProxy_m || previewOperation_m.type != EditOperation::None
+            || previewRGBImage_m.data != masterRGBImage_m.data)
+        return true;
+
+    switch (ui->toolMenu->currentIndex())
+    {
+    case 0:
+        return !(operation == adjustMenu_m->defaultOperation());
+    case 2:
+        return !(operation == temperatureMenu_m->defaultOperation());
+    default:
+        return operation.type != EditOperation::None;
+    }
+}
+
+/* Sets the master buffer to the output of the edit graph through the stage of the active menu, so the
+ * menu edits the image with every earlier stage applied but none of the later ones, and sets the edited
+ * image to the output of every stage. The edited image is displayed until the menu renders a preview,
+ * so the later stages are only hidden while a slider edit is pending. Only the stages that are not
+ * cached are rendered. Both share the cached buffers, which are never written to.*/
+void MainWindow::loadActiveStageIntoMaster()
+{
+    if(editGraph_m.source().empty())
+        return;
+
+    try {
+        masterRGBImage_m = editGraph_m.output(activeStage());
+        editedRGBImage_m = editGraph_m.output();
+    } catch (const cv::Exception &e) {
+        statusBar()->showMessage(QString::fromStdString(e.msg), 5000);
+        masterRGBImage_m = editGraph_m.source();
+        editedRGBImage_m = masterRGBImage_m;
+    }
+}
+
+/* Appends the operation of the active menu to the edit graph and the undo history. If the preview was
+ * rendered from the master it is adopted as the cached output of the stage, else (the preview was rendered
+ * from the proxy) the operation is rendered from the cached full resolution input of the stage. This blocks
+ * the GUI thread as it is only done once when the operation is applied.*/
+void MainWindow::commitActiveEdit()
+{
+    EditOperation operation = activeMenuOperation();
+    if(operation.type == EditOperation::None || !hasPendingEdit(operation))
+        return;
+
+    statusBar()->showMessage("Applying...");
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QString message;
+    try {
+        //the preview is only kept if it is the exact full resolution result of the operation being applied
+        if(previewIsProxy_m || !(previewOperation_m == operation))
+            editGraph_m.appendOperation(operation);
+        else
+            editGraph_m.appendOperation(operation, previewRGBImage_m);
+        undoOperations_m.append(operation);
+        redoOperations_m.clear();
+    } catch (const cv::Exception &e) {
+        message = QString::fromStdString(e.msg);
+    }
+    QApplication::restoreOverrideCursor();
+    statusBar()->showMessage(message, 5000);
+}
+
+/* Applies the operation of the active menu to the full resolution tiles of the master, one tile at a
+ * time, and records it in the undo history. The crop region and
+ * scale size of the Transform menu are in pixels of the working copy so they are scaled to the tiles.
+ * This blocks the GUI thread as it is only done once when the operation is applied.*/
+void MainWindow::applyTiledEdit()
+{
+    EditOperation operation = activeMenuOperation();
+    if(operation.type == EditOperation::None || !hasPendingEdit(operation))
+        return;
+
+    if(operation.type == EditOperation::Crop || operation.type == EditOperation::Scale)
+    {
+        double scaleX = masterTiles_m.size().width / static_cast<double>(masterRGBImage_m.cols);
+        double scaleY = masterTiles_m.size().height / static_cast<double>(masterRGBImage_m.rows);
+        cv::Rect region = operation.region;
+        operation.region = cv::Rect(cvRound(region.x * scaleX), cvRound(region.y * scaleY),
+                                    cvRound(region.width * scaleX), cvRound(region.height * scaleY));
+        if(operation.type == EditOperation::Crop)
+            operation.region &= cv::Rect(cv::Point(0, 0), masterTiles_m.size());
+    }
+
+    statusBar()->showMessage("Applying...");
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QString message;
+    try {
+        applyTiledOperation(operation);
+        undoOperations_m.append(operation);
+        redoOperations_m.clear();
+    } catch (const cv::Exception &e) {
+        message = QString::fromStdString(e.msg);
+    }
+    QApplication::restoreOverrideCursor();
+    statusBar()->showMessage(message, 5000);
+}
+
+/* Renders the operation, in full resolution coordinates, from the tiles of the master into new tiles.
+ * The new tiles replace the master and the tiles it changed are kept in the compressed undo history.
+ * If the history can not be recorded the master is put back, so there is never an undo step for an
+ * edit that was not made. The working copy of the result becomes the source of the edit graph.
+ * May throw a cv::Exception.*/
+void MainWindow::applyTiledOperation(const EditOperation &operation)
+{
+    TiledImage editedTiles;
+    tiledProcessor_m.apply(operation, masterTiles_m, editedTiles);
+    masterTiles_m.swap(editedTiles);
+    try {
+        tileHistory_m.push(editedTiles, masterTiles_m);
+    } catch (const cv::Exception &e) {
+        masterTiles_m.swap(editedTiles);
+        throw;
+    }
+
+    cv::Mat workingImage;
+    masterTiles_m.toMat(workingImage, tiledWorkingSize());
+    editGraph_m.setSource(workingImage);
+}
+
+/* Returns the size of the working copy the menus edit when the master is tiled. The aspect ratio of
+ * the tiles is kept and the working copy holds about TILED_WORKING_PIXELS pixels.*/
+cv::Size MainWindow::tiledWorkingSize() const
+{
+    cv::Size full = masterTiles_m.size();
+    double scale = std::sqrt(TILED_WORKING_PIXELS / static_cast<double>(full.area()));
+    if(scale >= 1.0)
+        return full;
+    return cv::Size(std::max(1, cvRound(full.width * scale)), std::max(1, cvRound(full.height * scale)));
+}
+
+/* Shows the total time of each stage category (processing and displaying)
+ * recorded since the last preview in the status bar. If the QCVTOUCHUP_TRACE environment variable
+ * is set, the individual stages are written to the trace file when the application closes.*/
+void MainWindow::showStageTimings()
+{
+    QStringList timings;
+    for(const StageProfiler::Total &total : StageProfiler::instance().takeTotals())
+        timings.append(QString("%1 %2 ms").arg(total.category).arg(total.milliseconds, 0, 'f', 1));
+    stageTimingLabel_m->setText(timings.join(" | "));
+}
+
+/* saveImageAs converts the image from the RGB format used to display
  * the imagein Qt to BGR which is the OpenCV format. Then the method launches the save dialog to
  * perform the save operation */
 void MainWindow::saveImageAs()
 {
     qDebug() << userImagePath_m.absolutePath();
-
-    while(!mutex_m.tryLock())
-        QApplication::processEvents(QEventLoop::AllEvents, 100);
-
     statusBar()->showMessage("Saving...");
 
-    //first change back to OpenCV color space, save in preview, and display master (user must hit apply before saving)
-    imageWrapper_m = qcv::cvMatToQImage(masterRGBImage_m);
+    //first change back to OpenCV color space, save in preview, and display the edits (user must hit apply before saving)
+    imageWrapper_m = qcv::cvMatToQImage(editedRGBImage_m);
     updateImageInformation(&imageWrapper_m);
-    cv::cvtColor(masterRGBImage_m, previewRGBImage_m, cv::COLOR_RGB2BGR);
+    previewRGBImage_m.release(); //the preview may share a cached buffer of the edit graph (e.g. a crop)
+    if(masterTiles_m.empty())
+    {
+        //every stage of the edit graph is applied to the saved image, as it is displayed
+        try {
+            cv::cvtColor(editGraph_m.output(), previewRGBImage_m, cv::COLOR_RGB2BGR);
+        } catch (const cv::Exception &e) {
+            cv::cvtColor(masterRGBImage_m, previewRGBImage_m, cv::COLOR_RGB2BGR);
+            statusBar()->showMessage(QString::fromStdString(e.msg), 5000);
+        }
+    }
+    else
+    {
+        //a tiled master must be assembled at full resolution as OpenCV can not encode an image in parts
+        masterTiles_m.toMat(previewRGBImage_m);
+        cv::cvtColor(previewRGBImage_m, previewRGBImage_m, cv::COLOR_RGB2BGR);
+    }
 
     //launch the save dialog with the correct BGR image format in the preview
     ImageSaveDialog saveDialog(previewRGBImage_m, this, "Save As", userImagePath_m.absolutePath());
     saveDialog.exec();
-    cv::cvtColor(previewRGBImage_m, previewRGBImage_m, cv::COLOR_BGR2RGB);
-    mutex_m.unlock();
+    previewRGBImage_m = masterRGBImage_m;
+    previewOperation_m = EditOperation();
+    previewIsProxy_m = false;
     statusBar()->showMessage("");
 }
 
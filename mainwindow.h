@@ -38,6 +38,7 @@
 *
 * VERSION       DATE            WHO                     DETAIL
 * 0.1           11/03/2019      Matthew R. Miller       Initial Rev
+* 0.2           10/16/2026      agent                   Edit Graph, Proxy, Tiles, Undo
 *
 ************************************************************************/
 #ifndef MAINWINDOW_H
@@ -45,10 +46,17 @@
 
 #include <QMainWindow>
 #include <opencv2/core.hpp>
-#include <QMutex>
 #include <QDir>
+#include <QVector>
+#include "core/editgraph.h"
+#include "core/tiledprocessor.h"
+#include "core/tiledeltastore.h"
+#include "core/triplebuffer.h"
+#include "core/stageprofiler.h"
 class QImage;
 class QString;
+class QLabel;
+class QTimer;
 class AdjustMenu;
 class FilterMenu;
 class TemperatureMenu;
@@ -69,30 +77,65 @@ public:
 
 signals:
     void setImage(const QImage*);
-    void distributeImageBufferAddresses(const cv::Mat*, cv::Mat*);
+    void distributeImageBuffer(const cv::Mat&);
+    void distributeProxyBuffer(const cv::Mat&);
+    void distributeFullResolutionSize(const cv::Size&);
+    void imageChanged();
     void setDefaultTracking(bool);
 
-protected:
-    QMutex mutex_m;
-
 private slots:
     void imageOpenOperationFailed();
     void updateImageInformation(const QImage *image);
     void getImagePath();
     void cancelPreview();
     void applyPreviewToMaster();
+    void undoEdit();
+    void redoEdit();
     void displayPreview();
     void saveImageAs();
     bool loadImageIntoMemory(QString imagePath);
     void generateAboutDialog();
+    void scheduleWarmUp();
+    void menuWorkerReady();
+    void refreshProxyImage();
 
 private:
     void clearImageBuffers();
+    void showStageTimings();
+    void setUpTracking(bool openClAvailable);
+    void updateProxyImage();
+    cv::Size proxyImageSize() const;
+    void loadActiveStageIntoMaster();
+    void commitActiveEdit();
+    void applyTiledEdit();
+    void applyTiledOperation(const EditOperation &operation);
+    void displayEditedMaster();
+    void updateHistoryActions();
+    void clearHistory();
+    EditGraph::Stage activeStage() const;
+    EditOperation activeMenuOperation() const;
+    bool hasPendingEdit(const EditOperation &operation) const;
+    TripleBuffer *activePreviewFrames() const;
+    cv::Size tiledWorkingSize() const;
     Ui::MainWindow *ui;
     QDir userImagePath_m;
     cv::Mat masterRGBImage_m;
     cv::Mat previewRGBImage_m;
+    cv::Mat editedRGBImage_m; //the output of every stage of the edit graph, displayed while there is no preview
+    cv::Mat proxyRGBImage_m;
+    bool previewIsProxy_m;
+    bool trackingSetUp_m;
+    EditOperation previewOperation_m; //the operation the preview is the exact result of, else None
+    EditGraph editGraph_m;
+    TiledImage masterTiles_m;
+    TiledProcessor tiledProcessor_m;
+    TileDeltaStore tileHistory_m;
+    QVector<EditOperation> undoOperations_m;
+    QVector<EditOperation> redoOperations_m;
     QImage imageWrapper_m;
+    QLabel *stageTimingLabel_m;
+    QTimer *proxyTimer_m;
+    StageProfiler::Clock::time_point startupTime_m;
 
     //menus
     AdjustMenu *adjustMenu_m;
@@ -0,0 +1,108 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2017-11-11T18:37:42
+#
+#-------------------------------------------------
+
+QT       += core gui quick
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = qcvTouchUp
+
+TEMPLATE = app
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler).
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# The following line disables all the APIs deprecated before Qt 5.6.0
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x056000
+
+# The following line enables the OpenCV functionality in the ImageWidget custom class
+DEFINES += QT_OPENCV
+
+
+# These files are the QT source code and resources for qcvTouchUp
+SOURCES += \
+    imagelabel.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    imagewidget.cpp \
+    bufferwrappersqcv.cpp \
+    nav/quickmenu.cpp \
+    dialog/imagesavedialog.cpp \
+    dialog/imagesavejpegmenu.cpp \
+    dialog/imagesavepngmenu.cpp \
+    dialog/imagesavewebpmenu.cpp \
+    app_filters/mousewheelctrleatereventfilter.cpp \
+    app_filters/mousewheeleatereventfilter.cpp \
+    app_filters/signalsuppressor.cpp \
+    app_filters/focusindetectoreventfilter.cpp \
+    editing/menus/adjustmenu.cpp \
+    editing/menus/filtermenu.cpp \
+    editing/menus/temperaturemenu.cpp \
+    editing/menus/transformmenu.cpp \
+    #editing/menus/colorslicemenu.cpp \
+    #editing/menus/colorselectionwidget.cpp \
+    editing/workers/adjustworker.cpp \
+    editing/workers/filterworker.cpp \
+    editing/workers/temperatureworker.cpp \
+    editing/workers/transformworker.cpp \
+    batch/batchprocessor.cpp
+
+HEADERS += \
+    imagelabel.h \
+    mainwindow.h \
+    imagewidget.h \
+    bufferwrappersqcv.h \
+    nav/quickmenu.h \
+    dialog/imagesavedialog.h \
+    dialog/imagesavejpegmenu.h \
+    dialog/imagesavepngmenu.h \
+    dialog/imagesavewebpmenu.h \
+    app_filters/mousewheelctrleatereventfilter.h \
+    app_filters/mousewheeleatereventfilter.h \
+    app_filters/signalsuppressor.h \
+    app_filters/focusindetectoreventfilter.h \
+    editing/menus/adjustmenu.h \
+    editing/menus/filtermenu.h \
+    editing/menus/temperaturemenu.h \
+    editing/menus/transformmenu.h \
+    #editing/menus/colorslicemenu.h \
+    #editing/menus/colorselectionwidget.h \
+    editing/workers/adjustworker.h \
+    editing/workers/filterworker.h \
+    editing/workers/temperatureworker.h \
+    editing/workers/transformworker.h \
+    batch/batchprocessor.h
+
+FORMS += \
+    mainwindow.ui \
+    dialog/imagesavejpegmenu.ui \
+    dialog/imagesavepngmenu.ui \
+    dialog/imagesavewebpmenu.ui \
+    editing/menus/adjustmenu.ui \
+    editing/menus/filtermenu.ui \
+    editing/menus/temperaturemenu.ui \
+    editing/menus/transformmenu.ui
+    #editing/menus/colorslicemenu.ui \
+    #editing/menus/colorselectionwidget.ui
+
+RESOURCES += \
+    resources.qrc
+
+DISTFILES +=
+
+#makespec used to help determine qmake configuration for the project
+message($$QMAKESPEC)
+
+# The GUI free image processing core is linked statically before OpenCV
+include(core/core.pri)
+include(opencv.pri)
+
+#windows icon
+win32{
+    RC_ICONS += icons/masterIcons/rgb.ico
+}